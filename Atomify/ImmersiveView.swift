@@ -3,9 +3,8 @@ import RealityKit
 
 struct ImmersiveView: View {
     @StateObject private var lammps = LammpsWrapper()
-    @State private var oxygenEntities: [ModelEntity] = []
-    @State private var hydrogenEntities: [ModelEntity] = []
-    @State private var atomEntities: [ModelEntity] = []
+    // One entity array per atom type, matching the controller's type buckets
+    @State private var typeEntities: [[ModelEntity]] = []
     
     var body: some View {
         RealityView { content in
@@ -17,39 +16,30 @@ struct ImmersiveView: View {
     }
 
     private func startUpdatingPositions(sceneAnchor: AnchorEntity) {
-        Timer.scheduledTimer(withTimeInterval: 0.001, repeats: true) { timer in
-            lammps.step()
+        // Physics runs on the controller's simulation thread, the timer only renders
+        lammps.start()
+        Timer.scheduledTimer(withTimeInterval: 1.0 / 90.0, repeats: true) { timer in
             lammps.synchronize()
-            if (oxygenEntities.count == 0) {
+            if (typeEntities.count == 0) {
                 let oxygenMaterial = SimpleMaterial(color: .red, isMetallic: false)
                 let hydrogenMaterial = SimpleMaterial(color: .white, isMetallic: false)
-                for index in 0..<lammps.numAtoms {
-                    if (lammps.atomTypes[index] == 1) {
-                        let atom = ModelEntity(mesh: .generateSphere(radius: 0.5), materials: [oxygenMaterial])
+                for type in 1...max(lammps.numTypes, 1) {
+                    var entities: [ModelEntity] = []
+                    for _ in lammps.positions(ofType: type) {
+                        let atom = (type == 1)
+                            ? ModelEntity(mesh: .generateSphere(radius: 0.5), materials: [oxygenMaterial])
+                            : ModelEntity(mesh: .generateSphere(radius: 0.4), materials: [hydrogenMaterial])
                         atom.position = [0, 0, 0]
-                        oxygenEntities.append(atom)
-                        sceneAnchor.addChild(atom)
-                    } else {
-                        let atom = ModelEntity(mesh: .generateSphere(radius: 0.4), materials: [hydrogenMaterial])
-                        atom.position = [0, 0, 0]
-                        hydrogenEntities.append(atom)
+                        entities.append(atom)
                         sceneAnchor.addChild(atom)
                     }
+                    typeEntities.append(entities)
                 }
             }
             
-            var hydrogenCount = 0
-            var oxygenCount = 0
-            for index in 0..<lammps.numAtoms {
-                let position = lammps.positions[index]
-                let atomType = lammps.atomTypes[index]
-                if (atomType == 1) {
-                    // Oxygen
-                    oxygenEntities[oxygenCount].position = [position.x, position.y, position.z]
-                    oxygenCount += 1
-                } else {
-                    hydrogenEntities[hydrogenCount].position = [position.x, position.y, position.z]
-                    hydrogenCount += 1
+            for (typeIndex, entities) in typeEntities.enumerated() {
+                for (entity, position) in zip(entities, lammps.positions(ofType: typeIndex + 1)) {
+                    entity.position = position
                 }
             }
         }
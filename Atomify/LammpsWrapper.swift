@@ -11,17 +11,21 @@ extension NSValue {
 }
 
 class LammpsWrapper: ObservableObject {
-    @Published var positions: [SIMD3<Float>] = []
+    // Not @Published: the property wrapper would copy the arrays on every in-place write
+    private(set) var positions: [SIMD3<Float>] = []
+    private(set) var atomTypes: [Int32] = []  // Array of atom types as integers
+    // Atoms are grouped by type, type t is at typeOffsets[t-1]..<typeOffsets[t]
+    private(set) var typeOffsets: [Int32] = []
     @Published var numAtoms: Int = 0
-    @Published var atomTypes: [Int] = []  // Array of atom types as integers
+    @Published var numTypes: Int = 0
     private var controller: LammpsController
     
     init() {
         controller = LammpsController()
         controller.initializeWater()
         numAtoms = Int(controller.numAtoms)
+        numTypes = Int(controller.numTypes)
         updatePositions()
-        updateAtomTypes()
         print("Initialized LammpsWrapper with numAtoms: \(numAtoms)")
     }
     
@@ -29,30 +33,105 @@ class LammpsWrapper: ObservableObject {
         controller.step()
     }
     
+    // frameBudget is the wall time in seconds the simulation thread spends
+    // stepping between frames, 0 advances a fixed number of steps instead
+    func start(frameBudget: Double = 0.008) {
+        controller.frameBudget = frameBudget
+        controller.startSimulation()
+    }
+    
+    func stop() {
+        controller.stopSimulation()
+    }
+    
+    // Returns to the initial state of the scene. Restoring the in-memory
+    // snapshot is fast, a full reload is only needed if that fails.
     func reset() {
-        controller.reset()
-        controller.initializeLJ()
-        updateAtomTypes()
+        if !controller.restoreSnapshot() {
+            controller.reset()
+            controller.initializeWater()
+        }
+        synchronize()
     }
     
     func synchronize() {
+        if controller.isRunning {
+            updateFromLatestFrame()
+            return
+        }
         controller.synchronize()
         numAtoms = Int(controller.numAtoms)
+        numTypes = Int(controller.numTypes)
         updatePositions()
-        updateAtomTypes()
+    }
+    
+    // Contiguous positions of all atoms of the given type, ready for instancing
+    func positions(ofType type: Int) -> ArraySlice<SIMD3<Float>> {
+        guard type >= 1 && type < typeOffsets.count else { return [] }
+        return positions[Int(typeOffsets[type - 1])..<Int(typeOffsets[type])]
     }
     
     private func updatePositions() {
-        if let nsArray = controller.positions as? [Double] {
-            positions = stride(from: 0, to: nsArray.count, by: 3).map {
-                SIMD3<Float>(Float(nsArray[$0]), Float(nsArray[$0 + 1]), Float(nsArray[$0 + 2]))
+        if positions.count != numAtoms {
+            positions = [SIMD3<Float>](repeating: .zero, count: numAtoms)
+            atomTypes = [Int32](repeating: 0, count: numAtoms)
+        }
+        if typeOffsets.count != numTypes + 1 {
+            typeOffsets = [Int32](repeating: 0, count: numTypes + 1)
+        }
+        // Fill the arrays in place, no per-atom allocation
+        let capacity = Int32(numAtoms)
+        positions.withUnsafeMutableBufferPointer { positionBuffer in
+            atomTypes.withUnsafeMutableBufferPointer { typeBuffer in
+                typeOffsets.withUnsafeMutableBufferPointer { offsetBuffer in
+                    _ = controller.copyPositionBuckets(positionBuffer.baseAddress, types: typeBuffer.baseAddress, typeOffsets: offsetBuffer.baseAddress, capacity: capacity)
+                }
             }
         }
     }
     
-    private func updateAtomTypes() {
-        if let atomTypesFromController = controller.atomTypes as? [Int] {
-            atomTypes = atomTypesFromController
+    private func updateFromLatestFrame() {
+        var frameNumAtoms: Int32 = -1
+        var frameNumTypes: Int32 = 0
+        if !copyLatestFrame(numAtoms: &frameNumAtoms, numTypes: &frameNumTypes) {
+            // No new frame, or it did not fit and was kept: grow and copy it now
+            guard frameNumAtoms >= 0 else { return }
+            if Int(frameNumAtoms) > positions.count {
+                positions = [SIMD3<Float>](repeating: .zero, count: Int(frameNumAtoms))
+                atomTypes = [Int32](repeating: 0, count: Int(frameNumAtoms))
+            }
+            if typeOffsets.count < Int(frameNumTypes) + 1 {
+                typeOffsets = [Int32](repeating: 0, count: Int(frameNumTypes) + 1)
+            }
+            guard copyLatestFrame(numAtoms: &frameNumAtoms, numTypes: &frameNumTypes) else { return }
+        }
+        // Drop what is left over from a larger earlier frame
+        if Int(frameNumAtoms) < positions.count {
+            positions.removeLast(positions.count - Int(frameNumAtoms))
+            atomTypes.removeLast(atomTypes.count - Int(frameNumAtoms))
+        }
+        if Int(frameNumTypes) + 1 < typeOffsets.count {
+            typeOffsets.removeLast(typeOffsets.count - Int(frameNumTypes) - 1)
+        }
+        if numAtoms != Int(frameNumAtoms) {
+            numAtoms = Int(frameNumAtoms)
+        }
+        if numTypes != Int(frameNumTypes) {
+            numTypes = Int(frameNumTypes)
+        }
+    }
+    
+    private func copyLatestFrame(numAtoms frameNumAtoms: inout Int32, numTypes frameNumTypes: inout Int32) -> Bool {
+        let capacity = Int32(positions.count)
+        let offsetCapacity = Int32(typeOffsets.count)
+        var acquired = false
+        positions.withUnsafeMutableBufferPointer { positionBuffer in
+            atomTypes.withUnsafeMutableBufferPointer { typeBuffer in
+                typeOffsets.withUnsafeMutableBufferPointer { offsetBuffer in
+                    acquired = controller.copyLatestFrame(positionBuffer.baseAddress, types: typeBuffer.baseAddress, typeOffsets: offsetBuffer.baseAddress, capacity: capacity, offsetCapacity: offsetCapacity, numAtoms: &frameNumAtoms, numTypes: &frameNumTypes)
+                }
+            }
         }
+        return acquired
     }
 }
@@ -1,4 +1,5 @@
 #import <Foundation/Foundation.h>
+#import <simd/simd.h>
 
 @interface LammpsController : NSObject {
     void *lammpsObject; // Pointer to the LAMMPS instance
@@ -8,8 +9,10 @@
 // Properties
 @property (nonatomic, assign) void *lammpsObject;
 @property (nonatomic, assign) int numAtoms;
-@property (nonatomic, strong) NSMutableArray *positions;
-@property (nonatomic, strong) NSMutableArray *atomTypes;
+@property (nonatomic, assign) int numTypes; // Number of atom types, set by synchronize
+@property (nonatomic, assign) int stepsPerFrame; // Timesteps between published frames
+@property (nonatomic, assign) double frameBudget; // If > 0, wall time in seconds to step between published frames instead of stepsPerFrame
+@property (nonatomic, readonly) BOOL isRunning;
 
 // Methods
 - (void)reset;
@@ -18,4 +21,38 @@
 - (void)initializeWater;
 - (void)synchronize;
 
+// Keeps an in-memory copy of the current state (atoms, box, fix state).
+// initializeWater takes one when the scene is set up.
+- (void)takeSnapshot;
+
+// Returns to the state of the last takeSnapshot without re-reading the input,
+// data and potential files. Stops the simulation thread. Returns NO if there
+// is no snapshot or it no longer matches the simulation.
+- (BOOL)restoreSnapshot;
+
+// Copies wrapped positions and atom types into caller-owned buffers in a
+// single pass. Both buffers must hold at least `capacity` elements.
+// Returns the number of atoms written.
+- (int)copyPositions:(simd_float3 *)positions types:(int32_t *)types capacity:(int)capacity;
+
+// Like copyPositions, but groups the atoms by type so each bucket can be
+// uploaded as one instance buffer. Type t occupies the index range
+// [typeOffsets[t-1], typeOffsets[t]) in atom ID order. typeOffsets must hold
+// numTypes + 1 elements.
+- (int)copyPositionBuckets:(simd_float3 *)positions types:(int32_t *)types typeOffsets:(int32_t *)typeOffsets capacity:(int)capacity;
+
+// Background simulation. While running, the LAMMPS instance is owned by the
+// simulation thread and must only be read through copyLatestFrame.
+- (void)startSimulation;
+- (void)stopSimulation;
+
+// Copies the newest published frame into caller-owned buffers, with atoms
+// grouped by type as in copyPositionBuckets. positions and types hold capacity
+// elements, typeOffsets holds offsetCapacity elements. Returns NO and leaves the
+// buffers untouched if no frame was published since the last call. numAtoms and
+// numTypes receive the atom and type count of the frame. If the frame needs more
+// than capacity atoms or numTypes + 1 > offsetCapacity offsets, NO is returned
+// and the frame is kept, so the next call can copy it once the buffers were grown.
+- (BOOL)copyLatestFrame:(simd_float3 *)positions types:(int32_t *)types typeOffsets:(int32_t *)typeOffsets capacity:(int)capacity offsetCapacity:(int)offsetCapacity numAtoms:(int *)frameNumAtoms numTypes:(int *)frameNumTypes;
+
 @end
@@ -4,31 +4,156 @@
 #include "src/atom.h"
 #include "src/domain.h"
 
-@implementation LammpsController
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// One snapshot of the system as handed from the simulation thread to the renderer.
+// Atoms are bucketed by type, see snapshotPositions.
+struct LammpsFrame {
+    std::vector<simd_float3> positions;
+    std::vector<int32_t> types;
+    std::vector<int32_t> typeOffsets;
+    int numAtoms = 0;
+};
+
+// Reusable work arrays for snapshotPositions
+struct SnapshotScratch {
+    std::vector<double> x;
+    std::vector<int32_t> cursor;
+};
+
+// Bit set on the shared triple buffer slot when it holds a frame the reader has not seen
+static const int FRAME_FRESH = 4;
+
+// Upper limit for steps between frames when stepping by wall time budget
+static const int MAX_STEPS_PER_FRAME = 100000;
+
+// Writes positions and types ordered by atom ID, so renderers keep a stable
+// per-atom identity when LAMMPS sorts or reneighbors. The unwrapped
+// coordinates are staged in scratch so the periodic remap is one bulk pass.
+// If typeOffsets is given (ntypes + 1 entries), atoms are also grouped by
+// type with a counting sort: type t occupies [typeOffsets[t-1], typeOffsets[t])
+// and keeps the atom ID order within its bucket.
+static int snapshotPositions(LAMMPS_NS::LAMMPS *lammps, SnapshotScratch &scratch, simd_float3 *positions, int32_t *types, int capacity, int32_t *typeOffsets = nullptr) {
+    LAMMPS_NS::Atom *atom = lammps->atom;
+    LAMMPS_NS::Domain *domain = lammps->domain;
+
+    int nlocal = atom->nlocal;
+    int count = std::min(nlocal, capacity);
+    double **x = atom->x;
+    int *type = atom->type;
+    LAMMPS_NS::tagint *tag = atom->tag;
+    bool ordered = atom->tag_enable && atom->tag_consecutive();
+
+    scratch.x.resize(3 * count);
+    double *xs = scratch.x.data();
+    for (int i = 0; i < nlocal; i++) {
+        int j = ordered ? (int)(tag[i] - 1) : i;
+        if (j >= count) {
+            continue;
+        }
+        xs[3*j+0] = x[i][0];
+        xs[3*j+1] = x[i][1];
+        xs[3*j+2] = x[i][2];
+        types[j] = type[i];
+    }
+
+    domain->remap_all(count, xs); // remap into system boundaries with PBC
+
+    if (!typeOffsets) {
+        for (int j = 0; j < count; j++) {
+            positions[j] = simd_make_float3((float)xs[3*j+0], (float)xs[3*j+1], (float)xs[3*j+2]);
+        }
+        return count;
+    }
+
+    int ntypes = atom->ntypes;
+    std::fill(typeOffsets, typeOffsets + ntypes + 1, 0);
+    for (int j = 0; j < count; j++) {
+        typeOffsets[types[j]]++;
+    }
+    for (int t = 1; t <= ntypes; t++) {
+        typeOffsets[t] += typeOffsets[t-1];
+    }
+
+    scratch.cursor.assign(typeOffsets, typeOffsets + ntypes); // start of each bucket
+    int32_t *cursor = scratch.cursor.data();
+    for (int j = 0; j < count; j++) {
+        int k = cursor[types[j] - 1]++;
+        positions[k] = simd_make_float3((float)xs[3*j+0], (float)xs[3*j+1], (float)xs[3*j+2]);
+    }
+    for (int t = 1; t <= ntypes; t++) {
+        std::fill(types + typeOffsets[t-1], types + typeOffsets[t], t);
+    }
+
+    return count;
+}
+
+@implementation LammpsController {
+    // Triple buffer: the writer owns frames[backIndex], the reader owns
+    // frames[frontIndex] and the third slot is exchanged through sharedIndex.
+    LammpsFrame frames[3];
+    std::atomic<int> sharedIndex;
+    int backIndex;
+    int frontIndex;
+    // frames[frontIndex] was taken over but not copied out yet because it
+    // did not fit the reader's buffers
+    BOOL frontUnread;
+
+    std::thread simulationThread;
+    std::atomic<bool> simulationRunning;
+
+    SnapshotScratch positionScratch;
+
+    // In-memory copy of the state after the scene was set up, see restoreSnapshot
+    void *sceneSnapshot;
+}
 
 // Synthesize properties
 @synthesize lammpsObject;
 @synthesize numAtoms;
-@synthesize atomTypes;
-@synthesize positions;
+@synthesize numTypes;
+@synthesize stepsPerFrame;
+@synthesize frameBudget;
 
 - (instancetype)init {
     if (self = [super init]) {
         self.lammpsObject = NULL;
         self.numAtoms = 0;
-        self.atomTypes = nil;
-        self.positions = nil;
+        self.numTypes = 0;
+        self.stepsPerFrame = 1;
+        self.frameBudget = 0.0;
+        backIndex = 0;
+        sharedIndex.store(1);
+        frontIndex = 2;
+        frontUnread = NO;
+        simulationRunning.store(false);
         [self reset];
     }
     return self;
 }
 
+- (void)dealloc {
+    [self stopSimulation];
+    lammps_snapshot_free(sceneSnapshot);
+}
+
+- (BOOL)isRunning {
+    return simulationRunning.load();
+}
+
 - (void)reset {
+    [self stopSimulation];
+
     // Deallocate any previous LAMMPS instance
+    lammps_snapshot_free(sceneSnapshot);
+    sceneSnapshot = NULL;
     if (self.lammpsObject != NULL) {
         lammps_close(self.lammpsObject);
-        lammps_mpi_finalize();
-        lammps_close(self.lammpsObject);
+        self.lammpsObject = NULL;
     }
     
     int version;
@@ -44,6 +169,9 @@
         return;
     }
 
+    // thread the OPENMP styles over all cores, a no-op without OpenMP support
+    lammps_set_threads(self.lammpsObject, (int)[[NSProcessInfo processInfo] activeProcessorCount]);
+
     version = lammps_version(self.lammpsObject);
     printf("LAMMPS Version: %d\n",version);
 
@@ -68,55 +196,147 @@
     lammps_command(self.lammpsObject, "timestep 0.0002");
     
     [self synchronize];
+    [self takeSnapshot];
+}
+
+- (void)takeSnapshot {
+    if (!self.lammpsObject || simulationRunning.load()) {
+        return;
+    }
+    lammps_snapshot_free(sceneSnapshot);
+    sceneSnapshot = lammps_snapshot_create(self.lammpsObject);
+}
+
+- (BOOL)restoreSnapshot {
+    if (!self.lammpsObject || !sceneSnapshot) {
+        return NO;
+    }
+    [self stopSimulation];
+    if (lammps_snapshot_restore(self.lammpsObject, sceneSnapshot) != 0) {
+        return NO;
+    }
+    [self synchronize];
+    return YES;
 }
 
 - (void)step {
-    // Execute a single timestep
-    lammps_command(self.lammpsObject, "run 1 pre no post no");
+    if (simulationRunning.load()) {
+        return; // the simulation thread is already stepping
+    }
+    // Execute a single timestep, continuing the open incremental run
+    lammps_run_steps(self.lammpsObject, 1);
+}
+
+- (void)startSimulation {
+    if (!self.lammpsObject || simulationRunning.load()) {
+        return;
+    }
+    simulationRunning.store(true);
+
+    void *lammps = self.lammpsObject;
+    int steps = std::max(self.stepsPerFrame, 1);
+    double budget = self.frameBudget;
+    // The thread only captures C++ state so it does not retain self
+    LammpsFrame *frameSlots = frames;
+    std::atomic<int> *shared = &sharedIndex;
+    std::atomic<bool> *running = &simulationRunning;
+    int back = backIndex;
+    SnapshotScratch scratch;
+
+    simulationThread = std::thread([=]() mutable {
+        LAMMPS_NS::LAMMPS *lmp = (LAMMPS_NS::LAMMPS *)lammps;
+        while (running->load(std::memory_order_relaxed)) {
+            if (budget > 0.0) {
+                // As many steps as fit into the budget, at least one
+                lammps_run_budget(lammps, budget, MAX_STEPS_PER_FRAME);
+            } else {
+                lammps_run_steps(lammps, steps);
+            }
+
+            LammpsFrame &frame = frameSlots[back];
+            int natoms = lmp->atom->nlocal;
+            if ((int)frame.positions.size() < natoms) {
+                frame.positions.resize(natoms);
+                frame.types.resize(natoms);
+            }
+            frame.typeOffsets.resize(lmp->atom->ntypes + 1);
+            frame.numAtoms = snapshotPositions(lmp, scratch, frame.positions.data(), frame.types.data(), natoms, frame.typeOffsets.data());
+
+            // Publish the finished frame and take over whatever slot was shared
+            back = shared->exchange(back | FRAME_FRESH, std::memory_order_acq_rel) & ~FRAME_FRESH;
+        }
+    });
+}
+
+- (void)stopSimulation {
+    if (!simulationRunning.load()) {
+        return;
+    }
+    simulationRunning.store(false);
+    simulationThread.join();
+
+    // Restore the writer slot the thread ended on
+    int shared = sharedIndex.load() & ~FRAME_FRESH;
+    backIndex = 3 - shared - frontIndex;
+}
+
+- (BOOL)copyLatestFrame:(simd_float3 *)positions types:(int32_t *)types typeOffsets:(int32_t *)typeOffsets capacity:(int)capacity offsetCapacity:(int)offsetCapacity numAtoms:(int *)frameNumAtoms numTypes:(int *)frameNumTypes {
+    if (sharedIndex.load(std::memory_order_relaxed) & FRAME_FRESH) {
+        frontIndex = sharedIndex.exchange(frontIndex, std::memory_order_acq_rel) & ~FRAME_FRESH;
+        frontUnread = YES;
+    }
+    if (!frontUnread) {
+        return NO;
+    }
+
+    const LammpsFrame &frame = frames[frontIndex];
+    int noffsets = (int)frame.typeOffsets.size();
+    if (frameNumAtoms) {
+        *frameNumAtoms = frame.numAtoms;
+    }
+    if (frameNumTypes) {
+        *frameNumTypes = noffsets - 1;
+    }
+    if (frame.numAtoms > capacity || noffsets > offsetCapacity) {
+        // Keep the frame for the next call, after the caller has grown its buffers
+        return NO;
+    }
+    memcpy(positions, frame.positions.data(), frame.numAtoms * sizeof(simd_float3));
+    memcpy(types, frame.types.data(), frame.numAtoms * sizeof(int32_t));
+    memcpy(typeOffsets, frame.typeOffsets.data(), noffsets * sizeof(int32_t));
+    frontUnread = NO;
+    return YES;
 }
 
 - (void)synchronize {
     if (!self.lammpsObject) {
         NSLog(@"lammpsObject is null");
         return;
-    } else {
-        LAMMPS_NS::LAMMPS *lammps = (LAMMPS_NS::LAMMPS *)self.lammpsObject;
-        LAMMPS_NS::Atom *atom = lammps->atom;
-        LAMMPS_NS::Domain *domain = lammps->domain;
-        
-        self.numAtoms = atom->natoms;
-        
-        if (self.positions && self.positions.count != self.numAtoms) {
-            // Need to reallocate
-            self.positions = nil;
-        }
-        
-        if (self.atomTypes && self.atomTypes.count != self.numAtoms) {
-            // Need to reallocate
-            self.atomTypes = nil;
-        }
-        
-        if (!self.positions) {
-            self.positions = [[NSMutableArray alloc] initWithCapacity:3 * self.numAtoms]; // x, y, z
-        }
-        if (!self.atomTypes) {
-            self.atomTypes = [[NSMutableArray alloc] initWithCapacity: self.numAtoms];
-        }
-        
-        for (int i = 0; i < self.numAtoms; i++) {
-            double position[3];
-            position[0] = atom->x[i][0];
-            position[1] = atom->x[i][1];
-            position[2] = atom->x[i][2];
-            domain->remap(position); // remap into system boundaries with PBC
-            
-            self.positions[3*i+0] = @(position[0]);
-            self.positions[3*i+1] = @(position[1]);
-            self.positions[3*i+2] = @(position[2]);
-            self.atomTypes[i] = @(atom->type[i]);
-        }
-        
     }
+    LAMMPS_NS::LAMMPS *lammps = (LAMMPS_NS::LAMMPS *)self.lammpsObject;
+    self.numAtoms = lammps->atom->natoms;
+    self.numTypes = lammps->atom->ntypes;
+}
+
+- (int)copyPositions:(simd_float3 *)positions types:(int32_t *)types capacity:(int)capacity {
+    if (!self.lammpsObject) {
+        NSLog(@"lammpsObject is null");
+        return 0;
+    }
+    return snapshotPositions((LAMMPS_NS::LAMMPS *)self.lammpsObject, positionScratch, positions, types, capacity);
+}
+
+- (int)copyPositionBuckets:(simd_float3 *)positions types:(int32_t *)types typeOffsets:(int32_t *)typeOffsets capacity:(int)capacity {
+    if (!self.lammpsObject) {
+        NSLog(@"lammpsObject is null");
+        return 0;
+    }
+    LAMMPS_NS::LAMMPS *lammps = (LAMMPS_NS::LAMMPS *)self.lammpsObject;
+    if (lammps->atom->ntypes != self.numTypes) {
+        NSLog(@"numTypes is out of date, call synchronize first");
+        return 0;
+    }
+    return snapshotPositions(lammps, positionScratch, positions, types, capacity, typeOffsets);
 }
 
 
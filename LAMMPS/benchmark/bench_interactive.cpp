@@ -0,0 +1,239 @@
+// Benchmark of the embedded interactive loop: advance one step, then export
+// the wrapped positions and types the way the app does every frame.
+//
+// Each input script is replayed with its replicate command rewritten to
+// N N N for every requested N and its run commands removed. Results are
+// written as JSON, see README.md for the format.
+
+#include "library.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::vector<std::string> inputs;
+  std::vector<int> sizes = {1, 2, 4, 8, 16};
+  int steps = 200;
+  int warmup = 20;
+  int threads = 0;
+  bool command = false;
+  std::string output;
+};
+
+struct Stats {
+  double p50, p99, mean, max;
+};
+
+static void usage(const char *exe)
+{
+  fprintf(stderr,
+          "Usage: %s [options] input.in [input.in ...]\n"
+          "  -sizes 1,2,4,8,16   replicate factors per dimension\n"
+          "  -steps N            measured steps per case (default 200)\n"
+          "  -warmup N           unmeasured steps before measuring (default 20)\n"
+          "  -threads N          OpenMP threads set with lammps_set_threads()\n"
+          "  -command            step with 'run 1 pre no post no' instead of lammps_run_steps()\n"
+          "  -o file             write JSON to file instead of stdout\n",
+          exe);
+  exit(1);
+}
+
+static Options parse_args(int argc, char **argv)
+{
+  Options opt;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if ((arg == "-sizes") && (i + 1 < argc)) {
+      opt.sizes.clear();
+      std::stringstream list(argv[++i]);
+      std::string item;
+      while (std::getline(list, item, ',')) opt.sizes.push_back(atoi(item.c_str()));
+    } else if ((arg == "-steps") && (i + 1 < argc)) {
+      opt.steps = atoi(argv[++i]);
+    } else if ((arg == "-warmup") && (i + 1 < argc)) {
+      opt.warmup = atoi(argv[++i]);
+    } else if ((arg == "-threads") && (i + 1 < argc)) {
+      opt.threads = atoi(argv[++i]);
+    } else if (arg == "-command") {
+      opt.command = true;
+    } else if ((arg == "-o") && (i + 1 < argc)) {
+      opt.output = argv[++i];
+    } else if (arg[0] == '-') {
+      usage(argv[0]);
+    } else {
+      opt.inputs.push_back(arg);
+    }
+  }
+  if (opt.inputs.empty() || opt.sizes.empty() || (opt.steps < 1) || (opt.warmup < 0) ||
+      (opt.threads < 0))
+    usage(argv[0]);
+  return opt;
+}
+
+// return the input script with replicate set to n n n and without run commands.
+// a replicate command is inserted after read_data if the script has none.
+
+static std::vector<std::string> prepare_script(const std::string &file, int n)
+{
+  std::ifstream in(file);
+  if (!in) {
+    fprintf(stderr, "Cannot open input script %s\n", file.c_str());
+    exit(1);
+  }
+
+  std::vector<std::string> lines;
+  std::string line, replicate = "replicate " + std::to_string(n) + " " + std::to_string(n) + " " +
+      std::to_string(n);
+  bool replicated = false;
+  int read_data = -1;
+  while (std::getline(in, line)) {
+    std::stringstream words(line);
+    std::string cmd;
+    words >> cmd;
+    if (cmd == "run") continue;
+    if (cmd == "replicate") {
+      line = replicate;
+      replicated = true;
+    }
+    if (cmd == "read_data") read_data = static_cast<int>(lines.size());
+    lines.push_back(line);
+  }
+  if (!replicated && (read_data >= 0)) lines.insert(lines.begin() + read_data + 1, replicate);
+  return lines;
+}
+
+static Stats summarize(std::vector<double> &samples)
+{
+  std::sort(samples.begin(), samples.end());
+  auto rank = [&](double q) {
+    auto idx = static_cast<size_t>(q * (samples.size() - 1) + 0.5);
+    return samples[idx];
+  };
+  double sum = 0.0;
+  for (double s : samples) sum += s;
+  return {rank(0.50), rank(0.99), sum / samples.size(), samples.back()};
+}
+
+static double elapsed_ms(Clock::time_point start, Clock::time_point stop)
+{
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+static void write_stats(FILE *fp, const char *name, const Stats &s)
+{
+  fprintf(fp, "\"%s\": {\"p50\": %.6f, \"p99\": %.6f, \"mean\": %.6f, \"max\": %.6f}", name, s.p50,
+          s.p99, s.mean, s.max);
+}
+
+int main(int argc, char **argv)
+{
+  Options opt = parse_args(argc, argv);
+
+  FILE *fp = stdout;
+  if (!opt.output.empty()) {
+    fp = fopen(opt.output.c_str(), "w");
+    if (!fp) {
+      fprintf(stderr, "Cannot open output file %s\n", opt.output.c_str());
+      return 1;
+    }
+  }
+
+  char cwd[4096];
+  if (!getcwd(cwd, sizeof(cwd))) return 1;
+
+  const char *lmpargv[] = {"liblammps", "-log", "none", "-screen", "none", "-nocite"};
+  int lmpargc = sizeof(lmpargv) / sizeof(const char *);
+
+  fprintf(fp,
+          "{\n  \"mode\": \"%s\",\n  \"steps\": %d,\n  \"warmup\": %d,\n  \"threads\": %d,\n"
+          "  \"results\": [",
+          opt.command ? "run 1 pre no post no" : "lammps_run_steps", opt.steps, opt.warmup,
+          opt.threads);
+
+  bool first = true;
+  for (const auto &input : opt.inputs) {
+    // scripts refer to their data and potential files relative to their directory
+
+    std::string dir = ".", name = input;
+    auto slash = input.rfind('/');
+    if (slash != std::string::npos) {
+      dir = input.substr(0, slash);
+      name = input.substr(slash + 1);
+    }
+
+    for (int n : opt.sizes) {
+      std::vector<std::string> script = prepare_script(input, n);
+      if (chdir(dir.c_str()) != 0) {
+        fprintf(stderr, "Cannot change to directory %s\n", dir.c_str());
+        return 1;
+      }
+
+      void *lmp = lammps_open_no_mpi(lmpargc, (char **) lmpargv, nullptr);
+      if (opt.threads > 0) lammps_set_threads(lmp, opt.threads);
+      for (const auto &line : script) lammps_command(lmp, line.c_str());
+      if (lammps_has_error(lmp)) {
+        char msg[1024];
+        lammps_get_last_error_message(lmp, msg, sizeof(msg));
+        fprintf(stderr, "Error in %s with replicate %d: %s\n", input.c_str(), n, msg);
+        return 1;
+      }
+
+      int natoms = static_cast<int>(lammps_get_natoms(lmp));
+      std::vector<double> x(3 * natoms);
+      std::vector<int> type(natoms);
+      std::vector<double> step_ms, export_ms;
+      step_ms.reserve(opt.steps);
+      export_ms.reserve(opt.steps);
+
+      Clock::time_point begin = Clock::now();
+      for (int i = 0; i < opt.warmup + opt.steps; i++) {
+        if (i == opt.warmup) begin = Clock::now();
+
+        Clock::time_point t0 = Clock::now();
+        if (opt.command)
+          lammps_command(lmp, "run 1 pre no post no");
+        else
+          lammps_run_steps(lmp, 1);
+        Clock::time_point t1 = Clock::now();
+        lammps_gather_positions_wrapped(lmp, x.data());
+        lammps_gather_atoms(lmp, "type", 0, 1, type.data());
+        Clock::time_point t2 = Clock::now();
+
+        if (i >= opt.warmup) {
+          step_ms.push_back(elapsed_ms(t0, t1));
+          export_ms.push_back(elapsed_ms(t1, t2));
+        }
+      }
+      double total = elapsed_ms(begin, Clock::now());
+      if (!opt.command) lammps_run_steps_end(lmp);
+      lammps_close(lmp);
+
+      if (chdir(cwd) != 0) return 1;
+
+      fprintf(fp, "%s\n    {\"input\": \"%s\", \"replicate\": %d, \"natoms\": %d, ", first ? "" : ",",
+              name.c_str(), n, natoms);
+      write_stats(fp, "step_ms", summarize(step_ms));
+      fprintf(fp, ", ");
+      write_stats(fp, "export_ms", summarize(export_ms));
+      fprintf(fp, ", \"steps_per_second\": %.3f}", 1000.0 * opt.steps / total);
+      fflush(fp);
+      first = false;
+    }
+  }
+  fprintf(fp, "\n  ]\n}\n");
+
+  if (fp != stdout) fclose(fp);
+  lammps_mpi_finalize();
+  return 0;
+}
@@ -76,6 +76,7 @@ PPPMElectrode::PPPMElectrode(LAMMPS *lmp) :
   if (lmp->citeme) lmp->citeme->add(cite_pppm_electrode);
 
   group_group_enable = 0;
+  async_support = 0;
   electrolyte_density_brick = nullptr;
   electrolyte_density_fft = nullptr;
   compute_vector_called = false;
@@ -255,7 +256,8 @@ void PPPMElectrode::init()
     mesg += fmt::format("  estimated absolute RMS force accuracy = {:.8g}\n", estimated_accuracy);
     mesg += fmt::format("  estimated relative force accuracy = {:.8g}\n",
                         estimated_accuracy / two_charge_force);
-    mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
+    mesg += fmt::format("  using {} precision {} FFTs\n", LMP_FFT_PREC,
+                        FFT3d::backend_name(fft_backend));
     mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n", ngrid_max, nfft_both_max);
     utils::logmesg(lmp, mesg);
   }
@@ -1073,11 +1075,11 @@ void PPPMElectrode::allocate()
 
   fft1 = new FFT3d(lmp, world, nx_pppm, ny_pppm, nz_pppm, nxlo_fft, nxhi_fft, nylo_fft, nyhi_fft,
                    nzlo_fft, nzhi_fft, nxlo_fft, nxhi_fft, nylo_fft, nyhi_fft, nzlo_fft, nzhi_fft,
-                   0, 0, &tmp, collective_flag);
+                   0, 0, &tmp, collective_flag, fft_backend);
 
   fft2 = new FFT3d(lmp, world, nx_pppm, ny_pppm, nz_pppm, nxlo_fft, nxhi_fft, nylo_fft, nyhi_fft,
                    nzlo_fft, nzhi_fft, nxlo_in, nxhi_in, nylo_in, nyhi_in, nzlo_in, nzhi_in, 0, 0,
-                   &tmp, collective_flag);
+                   &tmp, collective_flag, fft_backend);
 
   remap = new Remap(lmp, world, nxlo_in, nxhi_in, nylo_in, nyhi_in, nzlo_in, nzhi_in, nxlo_fft,
                     nxhi_fft, nylo_fft, nyhi_fft, nzlo_fft, nzhi_fft, 1, 0, 0, FFT_PRECISION,
@@ -60,6 +60,7 @@ PairVashishtaGPU::PairVashishtaGPU(LAMMPS *lmp) : PairVashishta(lmp), gpu_mode(G
   cpu_time = 0.0;
   reinitflag = 0;
   gpu_allocated = false;
+  shortlist_support = 0;
   suffix_flag |= Suffix::GPU;
   GPU_EXTRA::gpu_ready(lmp->modify, lmp->error);
 
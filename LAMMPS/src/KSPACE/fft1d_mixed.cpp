@@ -0,0 +1,493 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Self-sorting (Stockham) mixed-radix FFT with radix 4, 2, 3, 5
+   butterflies and a generic butterfly for other prime factors.
+
+   BATCH sequences are transposed into split real and imaginary work
+   arrays with the sequence index running fastest. every butterfly then
+   reads and writes runs of s*BATCH contiguous values with the same
+   twiddle factor, so the innermost loops vectorize without gathers.
+------------------------------------------------------------------------- */
+
+#include "fft1d_mixed.h"
+
+#include "lmptype.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+// number of sequences transformed together
+static constexpr int BATCH = 8;
+// upper limit for the number of factors of an int
+static constexpr int MAXSTAGE = 32;
+
+static constexpr double MY_2PI = 6.28318530717958647692;
+
+struct fft1d_mixed_stage {
+  int radix;                   // radix p of this stage
+  int m;                       // sub-sequence length / p = number of twiddles
+  int len;                     // s*BATCH, run length of one butterfly input
+  FFT_SCALAR *twr, *twi;       // twiddles for j < m and 1 <= t < p
+  FFT_SCALAR *dftr, *dfti;     // p-th roots of unity for the generic radix
+};
+
+struct fft1d_mixed_plan {
+  int n;                       // FFT length
+  int nstage;                  // number of radix stages
+  struct fft1d_mixed_stage stage[MAXSTAGE];
+  FFT_SCALAR *work;            // 2 buffers of n*BATCH split complex values
+};
+
+/* ----------------------------------------------------------------------
+   create plan: factor n and precompute twiddle factors per stage
+------------------------------------------------------------------------- */
+
+struct fft1d_mixed_plan *fft1d_mixed_create(int n)
+{
+  if (n < 1) return nullptr;
+
+  auto plan = (struct fft1d_mixed_plan *) calloc(1,sizeof(struct fft1d_mixed_plan));
+  if (plan == nullptr) return nullptr;
+  plan->n = n;
+
+  // radix 4 first, then remaining prime factors in increasing order
+
+  int radix[MAXSTAGE];
+  int nstage = 0;
+  int rest = n;
+  while (rest % 4 == 0) {
+    radix[nstage++] = 4;
+    rest /= 4;
+  }
+  for (int p = 2; p*p <= rest;) {
+    if (rest % p == 0) {
+      radix[nstage++] = p;
+      rest /= p;
+    } else ++p;
+  }
+  if (rest > 1) radix[nstage++] = rest;
+  plan->nstage = nstage;
+
+  // stage st splits sub-sequences of length nsub into p sub-sequences
+  // of length m and multiplies by the twiddles exp(+-2 pi i j t / nsub)
+
+  int nsub = n;
+  int s = 1;
+  for (int st = 0; st < nstage; ++st) {
+    struct fft1d_mixed_stage &stage = plan->stage[st];
+    const int p = radix[st];
+    const int m = nsub / p;
+    stage.radix = p;
+    stage.m = m;
+    stage.len = s*BATCH;
+
+    const int ntw = m * (p-1);
+    stage.twr = (FFT_SCALAR *) malloc(2*(ntw > 0 ? ntw : 1)*sizeof(FFT_SCALAR));
+    if (stage.twr == nullptr) {
+      fft1d_mixed_destroy(plan);
+      return nullptr;
+    }
+    stage.twi = stage.twr + ntw;
+    for (int j = 0; j < m; ++j) {
+      for (int t = 1; t < p; ++t) {
+        const double arg = MY_2PI * (double) (((int64_t) j*t) % nsub) / nsub;
+        stage.twr[j*(p-1) + t-1] = cos(arg);
+        stage.twi[j*(p-1) + t-1] = sin(arg);
+      }
+    }
+
+    if (p > 5) {
+      stage.dftr = (FFT_SCALAR *) malloc(2*p*sizeof(FFT_SCALAR));
+      if (stage.dftr == nullptr) {
+        fft1d_mixed_destroy(plan);
+        return nullptr;
+      }
+      stage.dfti = stage.dftr + p;
+      for (int k = 0; k < p; ++k) {
+        stage.dftr[k] = cos(MY_2PI * k / p);
+        stage.dfti[k] = sin(MY_2PI * k / p);
+      }
+    }
+
+    nsub = m;
+    s *= p;
+  }
+
+  plan->work = (FFT_SCALAR *) malloc(4*(size_t)n*BATCH*sizeof(FFT_SCALAR));
+  if (plan->work == nullptr) {
+    fft1d_mixed_destroy(plan);
+    return nullptr;
+  }
+  return plan;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void fft1d_mixed_destroy(struct fft1d_mixed_plan *plan)
+{
+  if (plan == nullptr) return;
+  for (int st = 0; st < plan->nstage; ++st) {
+    free(plan->stage[st].twr);
+    free(plan->stage[st].dftr);
+  }
+  free(plan->work);
+  free(plan);
+}
+
+/* ----------------------------------------------------------------------
+   butterflies for one stage. input run r of twiddle group j starts at
+   len*(j + r*m), output run t at len*(p*j + t). sg = -1 for forward FFTs
+------------------------------------------------------------------------- */
+
+static void radix2(const struct fft1d_mixed_stage &stage, const FFT_SCALAR *xr,
+                   const FFT_SCALAR *xi, FFT_SCALAR *_noalias yr, FFT_SCALAR *_noalias yi,
+                   const FFT_SCALAR sg)
+{
+  const int m = stage.m;
+  const int len = stage.len;
+
+  for (int j = 0; j < m; ++j) {
+    const FFT_SCALAR w1r = stage.twr[j];
+    const FFT_SCALAR w1i = sg*stage.twi[j];
+    const FFT_SCALAR *_noalias a0r = xr + len*j;
+    const FFT_SCALAR *_noalias a0i = xi + len*j;
+    const FFT_SCALAR *_noalias a1r = xr + len*(j+m);
+    const FFT_SCALAR *_noalias a1i = xi + len*(j+m);
+    FFT_SCALAR *_noalias b0r = yr + len*2*j;
+    FFT_SCALAR *_noalias b0i = yi + len*2*j;
+    FFT_SCALAR *_noalias b1r = b0r + len;
+    FFT_SCALAR *_noalias b1i = b0i + len;
+
+    for (int u = 0; u < len; ++u) {
+      const FFT_SCALAR dr = a0r[u] - a1r[u];
+      const FFT_SCALAR di = a0i[u] - a1i[u];
+      b0r[u] = a0r[u] + a1r[u];
+      b0i[u] = a0i[u] + a1i[u];
+      b1r[u] = dr*w1r - di*w1i;
+      b1i[u] = dr*w1i + di*w1r;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+static void radix3(const struct fft1d_mixed_stage &stage, const FFT_SCALAR *xr,
+                   const FFT_SCALAR *xi, FFT_SCALAR *_noalias yr, FFT_SCALAR *_noalias yi,
+                   const FFT_SCALAR sg)
+{
+  const int m = stage.m;
+  const int len = stage.len;
+  const FFT_SCALAR c = -0.5;
+  const FFT_SCALAR d = sg*0.86602540378443864676;
+
+  for (int j = 0; j < m; ++j) {
+    const FFT_SCALAR w1r = stage.twr[2*j];
+    const FFT_SCALAR w1i = sg*stage.twi[2*j];
+    const FFT_SCALAR w2r = stage.twr[2*j+1];
+    const FFT_SCALAR w2i = sg*stage.twi[2*j+1];
+    const FFT_SCALAR *_noalias a0r = xr + len*j;
+    const FFT_SCALAR *_noalias a0i = xi + len*j;
+    const FFT_SCALAR *_noalias a1r = xr + len*(j+m);
+    const FFT_SCALAR *_noalias a1i = xi + len*(j+m);
+    const FFT_SCALAR *_noalias a2r = xr + len*(j+2*m);
+    const FFT_SCALAR *_noalias a2i = xi + len*(j+2*m);
+    FFT_SCALAR *_noalias b0r = yr + len*3*j;
+    FFT_SCALAR *_noalias b0i = yi + len*3*j;
+    FFT_SCALAR *_noalias b1r = b0r + len;
+    FFT_SCALAR *_noalias b1i = b0i + len;
+    FFT_SCALAR *_noalias b2r = b1r + len;
+    FFT_SCALAR *_noalias b2i = b1i + len;
+
+    for (int u = 0; u < len; ++u) {
+      const FFT_SCALAR sr = a1r[u] + a2r[u];
+      const FFT_SCALAR si = a1i[u] + a2i[u];
+      const FFT_SCALAR dr = d*(a1r[u] - a2r[u]);
+      const FFT_SCALAR di = d*(a1i[u] - a2i[u]);
+      const FFT_SCALAR tr = a0r[u] + c*sr;
+      const FFT_SCALAR ti = a0i[u] + c*si;
+      b0r[u] = a0r[u] + sr;
+      b0i[u] = a0i[u] + si;
+      const FFT_SCALAR c1r = tr - di;
+      const FFT_SCALAR c1i = ti + dr;
+      const FFT_SCALAR c2r = tr + di;
+      const FFT_SCALAR c2i = ti - dr;
+      b1r[u] = c1r*w1r - c1i*w1i;
+      b1i[u] = c1r*w1i + c1i*w1r;
+      b2r[u] = c2r*w2r - c2i*w2i;
+      b2i[u] = c2r*w2i + c2i*w2r;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+static void radix4(const struct fft1d_mixed_stage &stage, const FFT_SCALAR *xr,
+                   const FFT_SCALAR *xi, FFT_SCALAR *_noalias yr, FFT_SCALAR *_noalias yi,
+                   const FFT_SCALAR sg)
+{
+  const int m = stage.m;
+  const int len = stage.len;
+
+  for (int j = 0; j < m; ++j) {
+    const FFT_SCALAR w1r = stage.twr[3*j];
+    const FFT_SCALAR w1i = sg*stage.twi[3*j];
+    const FFT_SCALAR w2r = stage.twr[3*j+1];
+    const FFT_SCALAR w2i = sg*stage.twi[3*j+1];
+    const FFT_SCALAR w3r = stage.twr[3*j+2];
+    const FFT_SCALAR w3i = sg*stage.twi[3*j+2];
+    const FFT_SCALAR *_noalias a0r = xr + len*j;
+    const FFT_SCALAR *_noalias a0i = xi + len*j;
+    const FFT_SCALAR *_noalias a1r = xr + len*(j+m);
+    const FFT_SCALAR *_noalias a1i = xi + len*(j+m);
+    const FFT_SCALAR *_noalias a2r = xr + len*(j+2*m);
+    const FFT_SCALAR *_noalias a2i = xi + len*(j+2*m);
+    const FFT_SCALAR *_noalias a3r = xr + len*(j+3*m);
+    const FFT_SCALAR *_noalias a3i = xi + len*(j+3*m);
+    FFT_SCALAR *_noalias b0r = yr + len*4*j;
+    FFT_SCALAR *_noalias b0i = yi + len*4*j;
+    FFT_SCALAR *_noalias b1r = b0r + len;
+    FFT_SCALAR *_noalias b1i = b0i + len;
+    FFT_SCALAR *_noalias b2r = b1r + len;
+    FFT_SCALAR *_noalias b2i = b1i + len;
+    FFT_SCALAR *_noalias b3r = b2r + len;
+    FFT_SCALAR *_noalias b3i = b2i + len;
+
+    for (int u = 0; u < len; ++u) {
+      const FFT_SCALAR s02r = a0r[u] + a2r[u];
+      const FFT_SCALAR s02i = a0i[u] + a2i[u];
+      const FFT_SCALAR d02r = a0r[u] - a2r[u];
+      const FFT_SCALAR d02i = a0i[u] - a2i[u];
+      const FFT_SCALAR s13r = a1r[u] + a3r[u];
+      const FFT_SCALAR s13i = a1i[u] + a3i[u];
+      // sg * i * (a1 - a3)
+      const FFT_SCALAR d13r = -sg*(a1i[u] - a3i[u]);
+      const FFT_SCALAR d13i = sg*(a1r[u] - a3r[u]);
+      b0r[u] = s02r + s13r;
+      b0i[u] = s02i + s13i;
+      const FFT_SCALAR c1r = d02r + d13r;
+      const FFT_SCALAR c1i = d02i + d13i;
+      const FFT_SCALAR c2r = s02r - s13r;
+      const FFT_SCALAR c2i = s02i - s13i;
+      const FFT_SCALAR c3r = d02r - d13r;
+      const FFT_SCALAR c3i = d02i - d13i;
+      b1r[u] = c1r*w1r - c1i*w1i;
+      b1i[u] = c1r*w1i + c1i*w1r;
+      b2r[u] = c2r*w2r - c2i*w2i;
+      b2i[u] = c2r*w2i + c2i*w2r;
+      b3r[u] = c3r*w3r - c3i*w3i;
+      b3i[u] = c3r*w3i + c3i*w3r;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+static void radix5(const struct fft1d_mixed_stage &stage, const FFT_SCALAR *xr,
+                   const FFT_SCALAR *xi, FFT_SCALAR *_noalias yr, FFT_SCALAR *_noalias yi,
+                   const FFT_SCALAR sg)
+{
+  const int m = stage.m;
+  const int len = stage.len;
+  const FFT_SCALAR c1 = 0.30901699437494742410;     // cos(2pi/5)
+  const FFT_SCALAR c2 = -0.80901699437494742410;    // cos(4pi/5)
+  const FFT_SCALAR d1 = sg*0.95105651629515357212;  // sin(2pi/5)
+  const FFT_SCALAR d2 = sg*0.58778525229247312917;  // sin(4pi/5)
+
+  for (int j = 0; j < m; ++j) {
+    const FFT_SCALAR *tr = stage.twr + 4*j;
+    const FFT_SCALAR *ti = stage.twi + 4*j;
+    const FFT_SCALAR w1r = tr[0], w1i = sg*ti[0];
+    const FFT_SCALAR w2r = tr[1], w2i = sg*ti[1];
+    const FFT_SCALAR w3r = tr[2], w3i = sg*ti[2];
+    const FFT_SCALAR w4r = tr[3], w4i = sg*ti[3];
+    const FFT_SCALAR *_noalias a0r = xr + len*j;
+    const FFT_SCALAR *_noalias a0i = xi + len*j;
+    const FFT_SCALAR *_noalias a1r = xr + len*(j+m);
+    const FFT_SCALAR *_noalias a1i = xi + len*(j+m);
+    const FFT_SCALAR *_noalias a2r = xr + len*(j+2*m);
+    const FFT_SCALAR *_noalias a2i = xi + len*(j+2*m);
+    const FFT_SCALAR *_noalias a3r = xr + len*(j+3*m);
+    const FFT_SCALAR *_noalias a3i = xi + len*(j+3*m);
+    const FFT_SCALAR *_noalias a4r = xr + len*(j+4*m);
+    const FFT_SCALAR *_noalias a4i = xi + len*(j+4*m);
+    FFT_SCALAR *_noalias b0r = yr + len*5*j;
+    FFT_SCALAR *_noalias b0i = yi + len*5*j;
+    FFT_SCALAR *_noalias b1r = b0r + len;
+    FFT_SCALAR *_noalias b1i = b0i + len;
+    FFT_SCALAR *_noalias b2r = b1r + len;
+    FFT_SCALAR *_noalias b2i = b1i + len;
+    FFT_SCALAR *_noalias b3r = b2r + len;
+    FFT_SCALAR *_noalias b3i = b2i + len;
+    FFT_SCALAR *_noalias b4r = b3r + len;
+    FFT_SCALAR *_noalias b4i = b3i + len;
+
+    for (int u = 0; u < len; ++u) {
+      const FFT_SCALAR s14r = a1r[u] + a4r[u];
+      const FFT_SCALAR s14i = a1i[u] + a4i[u];
+      const FFT_SCALAR d14r = a1r[u] - a4r[u];
+      const FFT_SCALAR d14i = a1i[u] - a4i[u];
+      const FFT_SCALAR s23r = a2r[u] + a3r[u];
+      const FFT_SCALAR s23i = a2i[u] + a3i[u];
+      const FFT_SCALAR d23r = a2r[u] - a3r[u];
+      const FFT_SCALAR d23i = a2i[u] - a3i[u];
+
+      b0r[u] = a0r[u] + s14r + s23r;
+      b0i[u] = a0i[u] + s14i + s23i;
+
+      const FFT_SCALAR t1r = a0r[u] + c1*s14r + c2*s23r;
+      const FFT_SCALAR t1i = a0i[u] + c1*s14i + c2*s23i;
+      const FFT_SCALAR u1r = d1*d14r + d2*d23r;
+      const FFT_SCALAR u1i = d1*d14i + d2*d23i;
+      const FFT_SCALAR t2r = a0r[u] + c2*s14r + c1*s23r;
+      const FFT_SCALAR t2i = a0i[u] + c2*s14i + c1*s23i;
+      const FFT_SCALAR u2r = d2*d14r - d1*d23r;
+      const FFT_SCALAR u2i = d2*d14i - d1*d23i;
+
+      // b1 = t1 + i u1, b4 = t1 - i u1, b2 = t2 + i u2, b3 = t2 - i u2
+      const FFT_SCALAR c1r = t1r - u1i;
+      const FFT_SCALAR c1i = t1i + u1r;
+      const FFT_SCALAR c4r = t1r + u1i;
+      const FFT_SCALAR c4i = t1i - u1r;
+      const FFT_SCALAR c2r = t2r - u2i;
+      const FFT_SCALAR c2i = t2i + u2r;
+      const FFT_SCALAR c3r = t2r + u2i;
+      const FFT_SCALAR c3i = t2i - u2r;
+
+      b1r[u] = c1r*w1r - c1i*w1i;
+      b1i[u] = c1r*w1i + c1i*w1r;
+      b2r[u] = c2r*w2r - c2i*w2i;
+      b2i[u] = c2r*w2i + c2i*w2r;
+      b3r[u] = c3r*w3r - c3i*w3i;
+      b3i[u] = c3r*w3i + c3i*w3r;
+      b4r[u] = c4r*w4r - c4i*w4i;
+      b4i[u] = c4r*w4i + c4i*w4r;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   direct DFT butterfly for prime factors > 5
+------------------------------------------------------------------------- */
+
+static void radixn(const struct fft1d_mixed_stage &stage, const FFT_SCALAR *xr,
+                   const FFT_SCALAR *xi, FFT_SCALAR *_noalias yr, FFT_SCALAR *_noalias yi,
+                   const FFT_SCALAR sg)
+{
+  const int p = stage.radix;
+  const int m = stage.m;
+  const int len = stage.len;
+
+  for (int j = 0; j < m; ++j) {
+    for (int t = 0; t < p; ++t) {
+      FFT_SCALAR *_noalias br = yr + len*(p*j + t);
+      FFT_SCALAR *_noalias bi = yi + len*(p*j + t);
+      const FFT_SCALAR *_noalias a0r = xr + len*j;
+      const FFT_SCALAR *_noalias a0i = xi + len*j;
+
+      for (int u = 0; u < len; ++u) {
+        br[u] = a0r[u];
+        bi[u] = a0i[u];
+      }
+
+      for (int r = 1; r < p; ++r) {
+        const int k = (r*t) % p;
+        const FFT_SCALAR er = stage.dftr[k];
+        const FFT_SCALAR ei = sg*stage.dfti[k];
+        const FFT_SCALAR *_noalias ar = xr + len*(j + r*m);
+        const FFT_SCALAR *_noalias ai = xi + len*(j + r*m);
+        for (int u = 0; u < len; ++u) {
+          br[u] += ar[u]*er - ai[u]*ei;
+          bi[u] += ar[u]*ei + ai[u]*er;
+        }
+      }
+
+      if (t > 0) {
+        const FFT_SCALAR wr = stage.twr[j*(p-1) + t-1];
+        const FFT_SCALAR wi = sg*stage.twi[j*(p-1) + t-1];
+        for (int u = 0; u < len; ++u) {
+          const FFT_SCALAR cr = br[u];
+          const FFT_SCALAR ci = bi[u];
+          br[u] = cr*wr - ci*wi;
+          bi[u] = cr*wi + ci*wr;
+        }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compute count in-place FFTs of length n stored one after another
+------------------------------------------------------------------------- */
+
+void fft1d_mixed_compute(struct fft1d_mixed_plan *plan, FFT_SCALAR *data, int count, int flag)
+{
+  const int n = plan->n;
+  if (n == 1) return;
+
+  const FFT_SCALAR sg = (flag == 1) ? -1.0 : 1.0;
+  const size_t nwork = (size_t) n*BATCH;
+
+  for (int b0 = 0; b0 < count; b0 += BATCH) {
+    const int nb = (count - b0 < BATCH) ? count - b0 : BATCH;
+    FFT_SCALAR *xr = plan->work;
+    FFT_SCALAR *xi = xr + nwork;
+    FFT_SCALAR *yr = xi + nwork;
+    FFT_SCALAR *yi = yr + nwork;
+
+    // transpose batch into split arrays with the sequence index fastest.
+    // unused lanes of a partial batch are zeroed
+
+    for (int v = 0; v < nb; ++v) {
+      const FFT_SCALAR *in = data + 2*((size_t) (b0+v))*n;
+      for (int k = 0; k < n; ++k) {
+        xr[k*BATCH + v] = in[2*k];
+        xi[k*BATCH + v] = in[2*k+1];
+      }
+    }
+    for (int v = nb; v < BATCH; ++v) {
+      for (int k = 0; k < n; ++k) {
+        xr[k*BATCH + v] = 0.0;
+        xi[k*BATCH + v] = 0.0;
+      }
+    }
+
+    for (int st = 0; st < plan->nstage; ++st) {
+      const struct fft1d_mixed_stage &stage = plan->stage[st];
+      switch (stage.radix) {
+      case 2: radix2(stage,xr,xi,yr,yi,sg); break;
+      case 3: radix3(stage,xr,xi,yr,yi,sg); break;
+      case 4: radix4(stage,xr,xi,yr,yi,sg); break;
+      case 5: radix5(stage,xr,xi,yr,yi,sg); break;
+      default: radixn(stage,xr,xi,yr,yi,sg); break;
+      }
+      FFT_SCALAR *tmp = xr;
+      xr = yr;
+      yr = tmp;
+      tmp = xi;
+      xi = yi;
+      yi = tmp;
+    }
+
+    for (int v = 0; v < nb; ++v) {
+      FFT_SCALAR *out = data + 2*((size_t) (b0+v))*n;
+      for (int k = 0; k < n; ++k) {
+        out[2*k] = xr[k*BATCH + v];
+        out[2*k+1] = xi[k*BATCH + v];
+      }
+    }
+  }
+}
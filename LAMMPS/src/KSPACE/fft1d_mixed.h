@@ -0,0 +1,32 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// built-in mixed-radix 1d FFT without external dependencies.
+// computes batches of contiguous complex 1d FFTs of the same length
+// with the batch as innermost, vectorizable loop dimension.
+
+#ifndef LMP_FFT1D_MIXED_H
+#define LMP_FFT1D_MIXED_H
+
+#include "lmpfftsettings.h"
+
+struct fft1d_mixed_plan;
+
+// plan for 1d FFTs of length n, nullptr if out of memory
+struct fft1d_mixed_plan *fft1d_mixed_create(int n);
+// in-place FFTs of count contiguous sequences of interleaved complex
+// values, flag = 1 for forward, -1 for (unnormalized) backward FFTs
+void fft1d_mixed_compute(struct fft1d_mixed_plan *, FFT_SCALAR *, int count, int flag);
+void fft1d_mixed_destroy(struct fft1d_mixed_plan *);
+
+#endif
@@ -36,6 +36,10 @@
 #include "kissfft.h"
 #endif
 
+#include "fft1d_mixed.h"
+
+#include <cstring>
+
 #define MIN(A,B) ((A) < (B) ? (A) : (B))
 #define MAX(A,B) ((A) > (B) ? (A) : (B))
 
@@ -76,14 +80,7 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
   FFT_SCALAR *out_ptr;
 #endif
   FFT_DATA *data,*copy;
-
-  // system specific constants
-
-#if defined(FFT_FFTW3)
-  FFTW_API(plan) theplan;
-#else
-  // nothing to do for other FFTs
-#endif
+  const struct fft_backend *backend = plan->backend;
 
   // pre-remap to prepare for 1st FFTs if needed
   // copy = loc for remap result
@@ -100,28 +97,7 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
   // 1d FFTs along fast axis
 
-#if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_fast,data);
-  else
-    DftiComputeBackward(plan->handle_fast,data);
-#elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_fast_forward;
-  else
-    theplan=plan->plan_fast_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-#else
-  int total = plan->total1;
-  int length = plan->length1;
-
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_fast_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_fast_backward,&data[offset],&data[offset]);
-#endif
+  backend->compute(plan->handle_fast,data,plan->total1/plan->length1,flag);
 
   // 1st mid-remap to prepare for 2nd FFTs
   // copy = loc for remap result
@@ -134,28 +110,7 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
   // 1d FFTs along mid axis
 
-#if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_mid,data);
-  else
-    DftiComputeBackward(plan->handle_mid,data);
-#elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_mid_forward;
-  else
-    theplan=plan->plan_mid_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-#else
-  total = plan->total2;
-  length = plan->length2;
-
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_mid_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_mid_backward,&data[offset],&data[offset]);
-#endif
+  backend->compute(plan->handle_mid,data,plan->total2/plan->length2,flag);
 
   // 2nd mid-remap to prepare for 3rd FFTs
   // copy = loc for remap result
@@ -168,28 +123,7 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
   // 1d FFTs along slow axis
 
-#if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_slow,data);
-  else
-    DftiComputeBackward(plan->handle_slow,data);
-#elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_slow_forward;
-  else
-    theplan=plan->plan_slow_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-#else
-  total = plan->total3;
-  length = plan->length3;
-
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_slow_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_slow_backward,&data[offset],&data[offset]);
-#endif
+  backend->compute(plan->handle_slow,data,plan->total3/plan->length3,flag);
 
   // post-remap to put data in output format if needed
   // destination is always out
@@ -248,7 +182,8 @@ struct fft_plan_3d *fft_3d_create_plan(
        int in_klo, int in_khi,
        int out_ilo, int out_ihi, int out_jlo, int out_jhi,
        int out_klo, int out_khi,
-       int scaled, int permute, int *nbuf, int usecollective)
+       int scaled, int permute, int *nbuf, int usecollective,
+       const char *backend)
 {
   struct fft_plan_3d *plan;
   int me,nprocs,nthreads;
@@ -475,113 +410,25 @@ struct fft_plan_3d *fft_3d_create_plan(
   }
   else plan->scratch = nullptr;
 
-  // system specific pre-computation of 1d FFT coeffs
-  // and scaling normalization
+  // create backend plans for the 1d FFTs along each axis
 
-#if defined(FFT_MKL)
-  DftiCreateDescriptor( &(plan->handle_fast), FFT_MKL_PREC, DFTI_COMPLEX, 1,
-                        (MKL_LONG)nfast);
-  DftiSetValue(plan->handle_fast, DFTI_NUMBER_OF_TRANSFORMS,
-               (MKL_LONG)plan->total1/nfast);
-  DftiSetValue(plan->handle_fast, DFTI_PLACEMENT,DFTI_INPLACE);
-  DftiSetValue(plan->handle_fast, DFTI_INPUT_DISTANCE, (MKL_LONG)nfast);
-  DftiSetValue(plan->handle_fast, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nfast);
-#if defined(FFT_MKL_THREADS)
-  DftiSetValue(plan->handle_fast, DFTI_NUMBER_OF_USER_THREADS, nthreads);
-#endif
-  DftiCommitDescriptor(plan->handle_fast);
-
-  DftiCreateDescriptor( &(plan->handle_mid), FFT_MKL_PREC, DFTI_COMPLEX, 1,
-                        (MKL_LONG)nmid);
-  DftiSetValue(plan->handle_mid, DFTI_NUMBER_OF_TRANSFORMS,
-               (MKL_LONG)plan->total2/nmid);
-  DftiSetValue(plan->handle_mid, DFTI_PLACEMENT,DFTI_INPLACE);
-  DftiSetValue(plan->handle_mid, DFTI_INPUT_DISTANCE, (MKL_LONG)nmid);
-  DftiSetValue(plan->handle_mid, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nmid);
-#if defined(FFT_MKL_THREADS)
-  DftiSetValue(plan->handle_mid, DFTI_NUMBER_OF_USER_THREADS, nthreads);
-#endif
-  DftiCommitDescriptor(plan->handle_mid);
-
-  DftiCreateDescriptor( &(plan->handle_slow), FFT_MKL_PREC, DFTI_COMPLEX, 1,
-                        (MKL_LONG)nslow);
-  DftiSetValue(plan->handle_slow, DFTI_NUMBER_OF_TRANSFORMS,
-               (MKL_LONG)plan->total3/nslow);
-  DftiSetValue(plan->handle_slow, DFTI_PLACEMENT,DFTI_INPLACE);
-  DftiSetValue(plan->handle_slow, DFTI_INPUT_DISTANCE, (MKL_LONG)nslow);
-  DftiSetValue(plan->handle_slow, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nslow);
-#if defined(FFT_MKL_THREADS)
-  DftiSetValue(plan->handle_slow, DFTI_NUMBER_OF_USER_THREADS, nthreads);
-#endif
-  DftiCommitDescriptor(plan->handle_slow);
+  plan->backend = fft_3d_find_backend(backend ? backend : fft_3d_default_backend());
+  if (plan->backend == nullptr) return nullptr;
 
-#elif defined(FFT_FFTW3)
-#if defined(FFT_FFTW_THREADS)
+#if defined(FFT_FFTW3) && defined(FFT_FFTW_THREADS)
   if (nthreads > 1) {
     FFTW_API(init_threads)();
     FFTW_API(plan_with_nthreads)(nthreads);
   }
 #endif
 
-  plan->plan_fast_forward =
-    FFTW_API(plan_many_dft)(1, &nfast,plan->total1/plan->length1,
-                            nullptr,&nfast,1,plan->length1,
-                            nullptr,&nfast,1,plan->length1,
-                            FFTW_FORWARD,FFTW_ESTIMATE);
-  plan->plan_fast_backward =
-    FFTW_API(plan_many_dft)(1, &nfast,plan->total1/plan->length1,
-                            nullptr,&nfast,1,plan->length1,
-                            nullptr,&nfast,1,plan->length1,
-                            FFTW_BACKWARD,FFTW_ESTIMATE);
-  plan->plan_mid_forward =
-    FFTW_API(plan_many_dft)(1, &nmid,plan->total2/plan->length2,
-                            nullptr,&nmid,1,plan->length2,
-                            nullptr,&nmid,1,plan->length2,
-                            FFTW_FORWARD,FFTW_ESTIMATE);
-  plan->plan_mid_backward =
-    FFTW_API(plan_many_dft)(1, &nmid,plan->total2/plan->length2,
-                            nullptr,&nmid,1,plan->length2,
-                            nullptr,&nmid,1,plan->length2,
-                            FFTW_BACKWARD,FFTW_ESTIMATE);
-  plan->plan_slow_forward =
-    FFTW_API(plan_many_dft)(1, &nslow,plan->total3/plan->length3,
-                            nullptr,&nslow,1,plan->length3,
-                            nullptr,&nslow,1,plan->length3,
-                            FFTW_FORWARD,FFTW_ESTIMATE);
-  plan->plan_slow_backward =
-    FFTW_API(plan_many_dft)(1, &nslow,plan->total3/plan->length3,
-                            nullptr,&nslow,1,plan->length3,
-                            nullptr,&nslow,1,plan->length3,
-                            FFTW_BACKWARD,FFTW_ESTIMATE);
-
-#else /* FFT_KISS */
-
-  plan->cfg_fast_forward = kiss_fft_alloc(nfast,0,nullptr,nullptr);
-  plan->cfg_fast_backward = kiss_fft_alloc(nfast,1,nullptr,nullptr);
-
-  if (nmid == nfast) {
-    plan->cfg_mid_forward = plan->cfg_fast_forward;
-    plan->cfg_mid_backward = plan->cfg_fast_backward;
-  }
-  else {
-    plan->cfg_mid_forward = kiss_fft_alloc(nmid,0,nullptr,nullptr);
-    plan->cfg_mid_backward = kiss_fft_alloc(nmid,1,nullptr,nullptr);
-  }
-
-  if (nslow == nfast) {
-    plan->cfg_slow_forward = plan->cfg_fast_forward;
-    plan->cfg_slow_backward = plan->cfg_fast_backward;
-  }
-  else if (nslow == nmid) {
-    plan->cfg_slow_forward = plan->cfg_mid_forward;
-    plan->cfg_slow_backward = plan->cfg_mid_backward;
-  }
-  else {
-    plan->cfg_slow_forward = kiss_fft_alloc(nslow,0,nullptr,nullptr);
-    plan->cfg_slow_backward = kiss_fft_alloc(nslow,1,nullptr,nullptr);
-  }
+  plan->handle_fast = plan->backend->create(nfast,plan->total1/plan->length1);
+  plan->handle_mid = plan->backend->create(nmid,plan->total2/plan->length2);
+  plan->handle_slow = plan->backend->create(nslow,plan->total3/plan->length3);
+  if ((plan->handle_fast == nullptr) || (plan->handle_mid == nullptr) ||
+      (plan->handle_slow == nullptr)) return nullptr;
 
-#endif
+  // scaling normalization
 
   if (scaled == 0)
     plan->scaled = 0;
@@ -609,33 +456,12 @@ void fft_3d_destroy_plan(struct fft_plan_3d *plan)
   if (plan->copy) free(plan->copy);
   if (plan->scratch) free(plan->scratch);
 
-#if defined(FFT_MKL)
-  DftiFreeDescriptor(&(plan->handle_fast));
-  DftiFreeDescriptor(&(plan->handle_mid));
-  DftiFreeDescriptor(&(plan->handle_slow));
-#elif defined(FFT_FFTW3)
-  FFTW_API(destroy_plan)(plan->plan_slow_forward);
-  FFTW_API(destroy_plan)(plan->plan_slow_backward);
-  FFTW_API(destroy_plan)(plan->plan_mid_forward);
-  FFTW_API(destroy_plan)(plan->plan_mid_backward);
-  FFTW_API(destroy_plan)(plan->plan_fast_forward);
-  FFTW_API(destroy_plan)(plan->plan_fast_backward);
-#if defined(FFT_FFTW_THREADS)
+  plan->backend->destroy(plan->handle_slow);
+  plan->backend->destroy(plan->handle_mid);
+  plan->backend->destroy(plan->handle_fast);
+#if defined(FFT_FFTW3) && defined(FFT_FFTW_THREADS)
   FFTW_API(cleanup_threads)();
 #endif
-#else
-  if (plan->cfg_slow_forward != plan->cfg_fast_forward &&
-      plan->cfg_slow_forward != plan->cfg_mid_forward) {
-    free(plan->cfg_slow_forward);
-    free(plan->cfg_slow_backward);
-  }
-  if (plan->cfg_mid_forward != plan->cfg_fast_forward) {
-    free(plan->cfg_mid_forward);
-    free(plan->cfg_mid_backward);
-  }
-  free(plan->cfg_fast_forward);
-  free(plan->cfg_fast_backward);
-#endif
 
   free(plan);
 }
@@ -730,13 +556,13 @@ void fft_1d_only(FFT_DATA *data, int nsize, int flag, struct fft_plan_3d *plan)
   int total3 = plan->total3;
   int length3 = plan->length3;
 
-// fftw3 and Dfti in MKL encode the number of transforms
-// into the plan, so we cannot operate on a smaller data set
+// some backends, like fftw3 and Dfti in MKL, encode the number of
+// transforms into the plan, so we cannot operate on a smaller data set
 
-#if defined(FFT_MKL) || defined(FFT_FFTW3)
-  if ((total1 > nsize) || (total2 > nsize) || (total3 > nsize))
+  if (plan->backend->fixed_count &&
+      ((total1 > nsize) || (total2 > nsize) || (total3 > nsize)))
     return;
-#endif
+
   if (total1 > nsize) total1 = (nsize/length1) * length1;
   if (total2 > nsize) total2 = (nsize/length2) * length2;
   if (total3 > nsize) total3 = (nsize/length3) * length3;
@@ -744,50 +570,9 @@ void fft_1d_only(FFT_DATA *data, int nsize, int flag, struct fft_plan_3d *plan)
   // perform 1d FFTs in each of 3 dimensions
   // data is just an array of 0.0
 
-#if defined(FFT_MKL)
-  if (flag == 1) {
-    DftiComputeForward(plan->handle_fast,data);
-    DftiComputeForward(plan->handle_mid,data);
-    DftiComputeForward(plan->handle_slow,data);
-  } else {
-    DftiComputeBackward(plan->handle_fast,data);
-    DftiComputeBackward(plan->handle_mid,data);
-    DftiComputeBackward(plan->handle_slow,data);
-  }
-#elif defined(FFT_FFTW3)
-  FFTW_API(plan) theplan;
-  if (flag == 1)
-    theplan=plan->plan_fast_forward;
-  else
-    theplan=plan->plan_fast_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-  if (flag == 1)
-    theplan=plan->plan_mid_forward;
-  else
-    theplan=plan->plan_mid_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-  if (flag == 1)
-    theplan=plan->plan_slow_forward;
-  else
-    theplan=plan->plan_slow_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-#else
-  if (flag == 1) {
-    for (int offset = 0; offset < total1; offset += length1)
-      kiss_fft(plan->cfg_fast_forward,&data[offset],&data[offset]);
-    for (int offset = 0; offset < total2; offset += length2)
-      kiss_fft(plan->cfg_mid_forward,&data[offset],&data[offset]);
-    for (int offset = 0; offset < total3; offset += length3)
-      kiss_fft(plan->cfg_slow_forward,&data[offset],&data[offset]);
-  } else {
-    for (int offset = 0; offset < total1; offset += length1)
-      kiss_fft(plan->cfg_fast_backward,&data[offset],&data[offset]);
-    for (int offset = 0; offset < total2; offset += length2)
-      kiss_fft(plan->cfg_mid_backward,&data[offset],&data[offset]);
-    for (int offset = 0; offset < total3; offset += length3)
-      kiss_fft(plan->cfg_slow_backward,&data[offset],&data[offset]);
-  }
-#endif
+  plan->backend->compute(plan->handle_fast,data,total1/length1,flag);
+  plan->backend->compute(plan->handle_mid,data,total2/length2,flag);
+  plan->backend->compute(plan->handle_slow,data,total3/length3,flag);
 
   // scaling if required
   // limit num to size of data
@@ -812,3 +597,201 @@ void fft_1d_only(FFT_DATA *data, int nsize, int flag, struct fft_plan_3d *plan)
     }
   }
 }
+
+/* ----------------------------------------------------------------------
+   1d FFT backends
+
+   the library backend wraps the FFT library selected at compile time.
+   the built-in "mixed" backend has no external dependencies and is the
+   default when no FFT library is available. additional backends can be
+   registered at runtime with fft_3d_register_backend() and selected by
+   name when creating a 3d FFT plan.
+------------------------------------------------------------------------- */
+
+#if defined(FFT_MKL)
+
+static void *fft_mkl_create(int length, int count)
+{
+  DFTI_DESCRIPTOR *handle;
+  DftiCreateDescriptor(&handle, FFT_MKL_PREC, DFTI_COMPLEX, 1, (MKL_LONG)length);
+  DftiSetValue(handle, DFTI_NUMBER_OF_TRANSFORMS, (MKL_LONG)count);
+  DftiSetValue(handle, DFTI_PLACEMENT,DFTI_INPLACE);
+  DftiSetValue(handle, DFTI_INPUT_DISTANCE, (MKL_LONG)length);
+  DftiSetValue(handle, DFTI_OUTPUT_DISTANCE, (MKL_LONG)length);
+#if defined(FFT_MKL_THREADS)
+#if defined(_OPENMP)
+  DftiSetValue(handle, DFTI_NUMBER_OF_USER_THREADS, omp_get_max_threads());
+#endif
+#endif
+  DftiCommitDescriptor(handle);
+  return (void *) handle;
+}
+
+static void fft_mkl_compute(void *handle, FFT_DATA *data, int, int flag)
+{
+  if (flag == 1)
+    DftiComputeForward((DFTI_DESCRIPTOR *) handle,data);
+  else
+    DftiComputeBackward((DFTI_DESCRIPTOR *) handle,data);
+}
+
+static void fft_mkl_destroy(void *handle)
+{
+  auto descriptor = (DFTI_DESCRIPTOR *) handle;
+  DftiFreeDescriptor(&descriptor);
+}
+
+static const struct fft_backend fft_library_backend =
+  {"mkl", 1, fft_mkl_create, fft_mkl_compute, fft_mkl_destroy};
+
+#elif defined(FFT_FFTW3)
+
+struct fft_fftw3_handle {
+  FFTW_API(plan) forward;
+  FFTW_API(plan) backward;
+};
+
+static void *fft_fftw3_create(int length, int count)
+{
+  auto handle = (struct fft_fftw3_handle *) malloc(sizeof(struct fft_fftw3_handle));
+  if (handle == nullptr) return nullptr;
+  handle->forward =
+    FFTW_API(plan_many_dft)(1, &length,count,
+                            nullptr,&length,1,length,
+                            nullptr,&length,1,length,
+                            FFTW_FORWARD,FFTW_ESTIMATE);
+  handle->backward =
+    FFTW_API(plan_many_dft)(1, &length,count,
+                            nullptr,&length,1,length,
+                            nullptr,&length,1,length,
+                            FFTW_BACKWARD,FFTW_ESTIMATE);
+  return (void *) handle;
+}
+
+static void fft_fftw3_compute(void *handle, FFT_DATA *data, int, int flag)
+{
+  auto plans = (struct fft_fftw3_handle *) handle;
+  FFTW_API(execute_dft)((flag == 1) ? plans->forward : plans->backward,data,data);
+}
+
+static void fft_fftw3_destroy(void *handle)
+{
+  auto plans = (struct fft_fftw3_handle *) handle;
+  FFTW_API(destroy_plan)(plans->forward);
+  FFTW_API(destroy_plan)(plans->backward);
+  free(plans);
+}
+
+static const struct fft_backend fft_library_backend =
+  {"fftw3", 1, fft_fftw3_create, fft_fftw3_compute, fft_fftw3_destroy};
+
+#else /* FFT_KISS */
+
+struct fft_kiss_handle {
+  kiss_fft_cfg forward;
+  kiss_fft_cfg backward;
+  int length;
+};
+
+static void *fft_kiss_create(int length, int)
+{
+  auto handle = (struct fft_kiss_handle *) malloc(sizeof(struct fft_kiss_handle));
+  if (handle == nullptr) return nullptr;
+  handle->forward = kiss_fft_alloc(length,0,nullptr,nullptr);
+  handle->backward = kiss_fft_alloc(length,1,nullptr,nullptr);
+  handle->length = length;
+  return (void *) handle;
+}
+
+static void fft_kiss_compute(void *handle, FFT_DATA *data, int count, int flag)
+{
+  auto cfg = (struct fft_kiss_handle *) handle;
+  const kiss_fft_cfg theplan = (flag == 1) ? cfg->forward : cfg->backward;
+  const int length = cfg->length;
+  for (int offset = 0; offset < count*length; offset += length)
+    kiss_fft(theplan,&data[offset],&data[offset]);
+}
+
+static void fft_kiss_destroy(void *handle)
+{
+  auto cfg = (struct fft_kiss_handle *) handle;
+  free(cfg->forward);
+  free(cfg->backward);
+  free(cfg);
+}
+
+static const struct fft_backend fft_library_backend =
+  {"kiss", 0, fft_kiss_create, fft_kiss_compute, fft_kiss_destroy};
+
+#endif
+
+/* ---------------------------------------------------------------------- */
+
+static void *fft_mixed_create(int length, int)
+{
+  return (void *) fft1d_mixed_create(length);
+}
+
+static void fft_mixed_compute(void *handle, FFT_DATA *data, int count, int flag)
+{
+  fft1d_mixed_compute((struct fft1d_mixed_plan *) handle,(FFT_SCALAR *) data,count,flag);
+}
+
+static void fft_mixed_destroy(void *handle)
+{
+  fft1d_mixed_destroy((struct fft1d_mixed_plan *) handle);
+}
+
+static const struct fft_backend fft_mixed_backend =
+  {"mixed", 0, fft_mixed_create, fft_mixed_compute, fft_mixed_destroy};
+
+/* ---------------------------------------------------------------------- */
+
+static constexpr int FFT_MAX_BACKEND = 8;
+static const struct fft_backend *fft_backends[FFT_MAX_BACKEND] =
+  {&fft_library_backend, &fft_mixed_backend};
+static int fft_nbackend = 2;
+
+/* ----------------------------------------------------------------------
+   add a backend to the list of available backends.
+   a backend with the same name as an existing one replaces it.
+   returns index of backend or -1 if the list is full
+------------------------------------------------------------------------- */
+
+int fft_3d_register_backend(const struct fft_backend *backend)
+{
+  for (int i = 0; i < fft_nbackend; i++) {
+    if (strcmp(fft_backends[i]->name,backend->name) == 0) {
+      fft_backends[i] = backend;
+      return i;
+    }
+  }
+  if (fft_nbackend == FFT_MAX_BACKEND) return -1;
+  fft_backends[fft_nbackend] = backend;
+  return fft_nbackend++;
+}
+
+/* ----------------------------------------------------------------------
+   return backend with the given name or nullptr if there is none
+------------------------------------------------------------------------- */
+
+const struct fft_backend *fft_3d_find_backend(const char *name)
+{
+  for (int i = 0; i < fft_nbackend; i++)
+    if (strcmp(fft_backends[i]->name,name) == 0) return fft_backends[i];
+  return nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   name of the backend used when none is requested: the FFT library,
+   if one was compiled in, otherwise the built-in mixed-radix FFT
+------------------------------------------------------------------------- */
+
+const char *fft_3d_default_backend()
+{
+#if defined(FFT_KISS)
+  return fft_mixed_backend.name;
+#else
+  return fft_library_backend.name;
+#endif
+}
@@ -86,6 +86,19 @@ typedef struct kiss_fft_state *kiss_fft_cfg;
 
 // -------------------------------------------------------------------------
 
+// a backend computes batches of in-place 1d FFTs of the same length,
+// stored one after the other. create() returns a plan for count FFTs
+// of the given length, compute() performs them with flag = 1 forward
+// and flag = -1 (unnormalized) backward.
+
+struct fft_backend {
+  const char *name;
+  int fixed_count;    // 1 if compute() must be called with the count of the plan
+  void *(*create)(int length, int count);
+  void (*compute)(void *handle, FFT_DATA *data, int count, int flag);
+  void (*destroy)(void *handle);
+};
+
 // details of how to do a 3d FFT
 
 struct fft_plan_3d {
@@ -103,26 +116,11 @@ struct fft_plan_3d {
   int normnum;    // # of values to rescale
   double norm;    // normalization factor for rescaling
 
-  // system specific 1d FFT info
-#if defined(FFT_MKL)
-  DFTI_DESCRIPTOR *handle_fast;
-  DFTI_DESCRIPTOR *handle_mid;
-  DFTI_DESCRIPTOR *handle_slow;
-#elif defined(FFT_FFTW3)
-  FFTW_API(plan) plan_fast_forward;
-  FFTW_API(plan) plan_fast_backward;
-  FFTW_API(plan) plan_mid_forward;
-  FFTW_API(plan) plan_mid_backward;
-  FFTW_API(plan) plan_slow_forward;
-  FFTW_API(plan) plan_slow_backward;
-#elif defined(FFT_KISS)
-  kiss_fft_cfg cfg_fast_forward;
-  kiss_fft_cfg cfg_fast_backward;
-  kiss_fft_cfg cfg_mid_forward;
-  kiss_fft_cfg cfg_mid_backward;
-  kiss_fft_cfg cfg_slow_forward;
-  kiss_fft_cfg cfg_slow_backward;
-#endif
+  // 1d FFTs along each axis
+  const struct fft_backend *backend;    // implementation of the 1d FFTs
+  void *handle_fast;                    // backend plans for each axis
+  void *handle_mid;
+  void *handle_slow;
 };
 
 // function prototypes
@@ -130,9 +128,12 @@ struct fft_plan_3d {
 extern "C" {
 void fft_3d(FFT_DATA *, FFT_DATA *, int, struct fft_plan_3d *);
 struct fft_plan_3d *fft_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int, int,
-                                       int, int, int, int, int, int, int, int *, int);
+                                       int, int, int, int, int, int, int, int *, int, const char *);
 void fft_3d_destroy_plan(struct fft_plan_3d *);
 void factor(int, int *, int *);
 void bifactor(int, int *, int *);
 void fft_1d_only(FFT_DATA *, int, int, struct fft_plan_3d *);
+int fft_3d_register_backend(const struct fft_backend *);
+const struct fft_backend *fft_3d_find_backend(const char *);
+const char *fft_3d_default_backend();
 }
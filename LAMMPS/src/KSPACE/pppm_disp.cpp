@@ -570,7 +570,8 @@ void PPPMDisp::init()
                           "= {:.8g}\n",acc);
       mesg += fmt::format("  Coulomb estimated relative force accuracy = {:.8g}\n",
                           acc/two_charge_force);
-      mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
+      mesg += fmt::format("  using {} precision {} FFTs\n",LMP_FFT_PREC,
+                          FFT3d::backend_name(fft_backend));
       mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                           ngrid_max,nfft_both_max);
       utils::logmesg(lmp,mesg);
@@ -594,7 +595,8 @@ void PPPMDisp::init()
                           "= {:.8}\n",acc_6);
       mesg += fmt::format("  Dispersion estimated relative force accuracy "
                           "= {:.8}\n",acc_6/two_charge_force);
-      mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
+      mesg += fmt::format("  using {} precision {} FFTs\n",LMP_FFT_PREC,
+                          FFT3d::backend_name(fft_backend));
       mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                           ngrid_6_max,nfft_both_6_max);
       utils::logmesg(lmp,mesg);
@@ -1780,12 +1782,12 @@ void _noopt PPPMDisp::allocate()
     fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                      nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                      nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                     0,0,&tmp,collective_flag);
+                     0,0,&tmp,collective_flag,fft_backend);
 
     fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                      nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                      nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                     0,0,&tmp,collective_flag);
+                     0,0,&tmp,collective_flag,fft_backend);
 
     remap = new Remap(lmp,world,
                       nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
@@ -1857,13 +1859,13 @@ void _noopt PPPMDisp::allocate()
       new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
                 nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
                 nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                0,0,&tmp,collective_flag);
+                0,0,&tmp,collective_flag,fft_backend);
 
     fft2_6 =
       new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
                 nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
                 nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
-                0,0,&tmp,collective_flag);
+                0,0,&tmp,collective_flag,fft_backend);
 
     remap_6 =
       new Remap(lmp,world,
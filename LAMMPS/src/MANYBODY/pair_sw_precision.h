@@ -0,0 +1,61 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(sw/mixed,PairSWMixed);
+PairStyle(sw/single,PairSWSingle);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_SW_PRECISION_H
+#define LMP_PAIR_SW_PRECISION_H
+
+#include "pair_sw.h"
+
+namespace LAMMPS_NS {
+
+// flt_t is used for coordinates, distances and the potential kernels,
+// acc_t for per-atom force accumulation and energy tally
+
+template <class flt_t, class acc_t> class PairSWPrecision : public PairSW {
+ public:
+  PairSWPrecision(class LAMMPS *);
+  ~PairSWPrecision() override;
+  void compute(int, int) override;
+  double memory_usage() override;
+
+  struct ParamT {
+    flt_t sigma, cut, cutsq, powerp, powerq, costheta;
+    flt_t sigma_gamma, lambda_epsilon, lambda_epsilon2;
+    flt_t c1, c2, c3, c4, c5, c6;
+  };
+
+ protected:
+  ParamT *fparams;    // parameters converted to flt_t
+  int nmax;           // allocated size of xf
+  flt_t *xf;          // coordinates of owned and ghost atoms, padded to 4
+
+  void setup_params() override;
+  void twobody_flt(const ParamT &, flt_t, flt_t &, int, flt_t &);
+  void threebody_flt(const ParamT &, const ParamT &, const ParamT &, flt_t, flt_t, flt_t *, flt_t *,
+                     flt_t *, flt_t *, int, flt_t &);
+};
+
+typedef PairSWPrecision<float, double> PairSWMixed;
+typedef PairSWPrecision<float, float> PairSWSingle;
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
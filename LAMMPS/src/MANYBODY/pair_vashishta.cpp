@@ -26,6 +26,7 @@
 #include "memory.h"
 #include "neighbor.h"
 #include "neigh_list.h"
+#include "neigh_request.h"
 #include "potential_file_reader.h"
 
 #include <cmath>
@@ -51,6 +52,10 @@ PairVashishta::PairVashishta(LAMMPS *lmp) : Pair(lmp)
   r0max = 0.0;
   maxshort = 10;
   neighshort = nullptr;
+
+  shortlist_flag = 0;
+  shortlist_support = 1;
+  listshort = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -83,6 +88,11 @@ void PairVashishta::compute(int eflag, int vflag)
   double delr1[3],delr2[3],fj[3],fk[3];
   int *ilist,*jlist,*numneigh,**firstneigh;
 
+  if (shortlist_flag) {
+    compute_shortlist(eflag,vflag);
+    return;
+  }
+
   evdwl = 0.0;
   ev_init(eflag,vflag);
 
@@ -217,6 +227,154 @@ void PairVashishta::compute(int eflag, int vflag)
   if (vflag_fdotr) virial_fdotr_compute();
 }
 
+/* ----------------------------------------------------------------------
+   compute with a half neighbor list for the two-body term and a full
+   neighbor list with the three-body cutoff, both built on reneighboring.
+   this avoids selecting half of the pairs and filtering the short
+   neighbors from the full list in every step.
+------------------------------------------------------------------------- */
+
+void PairVashishta::compute_shortlist(int eflag, int vflag)
+{
+  int i,j,k,ii,jj,kk,inum,jnum,jnumm1;
+  int itype,jtype,ktype,ijparam,ikparam,ijkparam;
+  double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
+  double rsq,rsq1,rsq2;
+  double delr1[3],delr2[3],fj[3],fk[3];
+  int *ilist,*jlist,*numneigh,**firstneigh;
+
+  evdwl = 0.0;
+  ev_init(eflag,vflag);
+
+  double **x = atom->x;
+  double **f = atom->f;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  int newton_pair = force->newton_pair;
+
+  double fxtmp,fytmp,fztmp;
+
+  // two-body interactions from half neighbor list
+
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    itype = map[type[i]];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    fxtmp = fytmp = fztmp = 0.0;
+
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+
+      jtype = map[type[j]];
+      ijparam = elem3param[itype][jtype][jtype];
+      if (rsq >= params[ijparam].cutsq) continue;
+
+      twobody(&params[ijparam],rsq,fpair,eflag,evdwl);
+
+      fxtmp += delx*fpair;
+      fytmp += dely*fpair;
+      fztmp += delz*fpair;
+      f[j][0] -= delx*fpair;
+      f[j][1] -= dely*fpair;
+      f[j][2] -= delz*fpair;
+
+      if (evflag) ev_tally(i,j,nlocal,newton_pair,
+                           evdwl,0.0,fpair,delx,dely,delz);
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
+
+  // three-body interactions from full neighbor list with short cutoff
+
+  inum = listshort->inum;
+  ilist = listshort->ilist;
+  numneigh = listshort->numneigh;
+  firstneigh = listshort->firstneigh;
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    itype = map[type[i]];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    fxtmp = fytmp = fztmp = 0.0;
+
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    jnumm1 = jnum - 1;
+
+    for (jj = 0; jj < jnumm1; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+      jtype = map[type[j]];
+      ijparam = elem3param[itype][jtype][jtype];
+      delr1[0] = x[j][0] - xtmp;
+      delr1[1] = x[j][1] - ytmp;
+      delr1[2] = x[j][2] - ztmp;
+      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
+      if (rsq1 >= params[ijparam].cutsq2) continue;
+
+      double fjxtmp,fjytmp,fjztmp;
+      fjxtmp = fjytmp = fjztmp = 0.0;
+
+      for (kk = jj+1; kk < jnum; kk++) {
+        k = jlist[kk];
+        k &= NEIGHMASK;
+        ktype = map[type[k]];
+        ikparam = elem3param[itype][ktype][ktype];
+        ijkparam = elem3param[itype][jtype][ktype];
+
+        delr2[0] = x[k][0] - xtmp;
+        delr2[1] = x[k][1] - ytmp;
+        delr2[2] = x[k][2] - ztmp;
+        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
+        if (rsq2 >= params[ikparam].cutsq2) continue;
+
+        threebody(&params[ijparam],&params[ikparam],&params[ijkparam],
+                  rsq1,rsq2,delr1,delr2,fj,fk,eflag,evdwl);
+
+        fxtmp -= fj[0] + fk[0];
+        fytmp -= fj[1] + fk[1];
+        fztmp -= fj[2] + fk[2];
+        fjxtmp += fj[0];
+        fjytmp += fj[1];
+        fjztmp += fj[2];
+        f[k][0] += fk[0];
+        f[k][1] += fk[1];
+        f[k][2] += fk[2];
+
+        if (evflag) ev_tally3(i,j,k,evdwl,0.0,fj,fk,delr1,delr2);
+      }
+      f[j][0] += fjxtmp;
+      f[j][1] += fjytmp;
+      f[j][2] += fjztmp;
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
 /* ---------------------------------------------------------------------- */
 
 void PairVashishta::allocate()
@@ -235,9 +393,25 @@ void PairVashishta::allocate()
    global settings
 ------------------------------------------------------------------------- */
 
-void PairVashishta::settings(int narg, char **/*arg*/)
+void PairVashishta::settings(int narg, char **arg)
 {
-  if (narg != 0) error->all(FLERR,"Illegal pair_style command");
+  // process optional keywords
+
+  shortlist_flag = 0;
+
+  int iarg = 0;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"shortlist") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "pair_style vashishta", error);
+      shortlist_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else error->all(FLERR, "Illegal pair_style vashishta keyword: {}", arg[iarg]);
+  }
+
+  // accelerated variants with their own single full list compute() clear shortlist_support
+
+  if (shortlist_flag && !shortlist_support)
+    error->all(FLERR, "Pair style {} does not support the shortlist keyword", force->pair_style);
 }
 
 /* ----------------------------------------------------------------------
@@ -267,9 +441,25 @@ void PairVashishta::init_style()
   if (force->newton_pair == 0)
     error->all(FLERR,"Pair style Vashishta requires newton pair on");
 
-  // need a full neighbor list
+  // need a full neighbor list, or with shortlist a half list for the
+  // two-body term and a full list with the three-body cutoff
+
+  if (shortlist_flag) {
+    neighbor->add_request(this);
+    auto req = neighbor->add_request(this, NeighConst::REQ_FULL);
+    req->set_id(1);
+    req->set_cutoff(r0max);
+  } else neighbor->add_request(this, NeighConst::REQ_FULL);
+}
 
-  neighbor->add_request(this, NeighConst::REQ_FULL);
+/* ----------------------------------------------------------------------
+   neighbor callback to inform pair style of neighbor list to use
+------------------------------------------------------------------------- */
+
+void PairVashishta::init_list(int id, NeighList *ptr)
+{
+  if (id == 1) listshort = ptr;
+  else list = ptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -0,0 +1,364 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_vashishta_precision.h"
+
+#include "atom.h"
+#include "force.h"
+#include "memory.h"
+#include "neigh_list.h"
+
+#include <cmath>
+
+using namespace LAMMPS_NS;
+
+// exponentials of arguments below -30 are dropped, they are far below
+// single precision resolution and products of them turn into denormals
+// which are very slow on most CPUs
+
+template <class T> static inline T exp_cut(T arg)
+{
+  return (arg > T(-30.0)) ? std::exp(arg) : T(0.0);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+PairVashishtaPrecision<flt_t,acc_t>::PairVashishtaPrecision(LAMMPS *lmp) : PairVashishta(lmp)
+{
+  shortlist_support = 0;
+  fparams = nullptr;
+  nmax = 0;
+  xf = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+PairVashishtaPrecision<flt_t,acc_t>::~PairVashishtaPrecision()
+{
+  memory->destroy(fparams);
+  memory->destroy(xf);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairVashishtaPrecision<flt_t,acc_t>::compute(int eflag, int vflag)
+{
+  int i,j,k,ii,jj,kk,inum,jnum,jnumm1;
+  int itype,jtype,ktype,ijparam,ikparam,ijkparam;
+  tagint itag,jtag;
+  flt_t xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
+  flt_t rsq,rsq1,rsq2;
+  flt_t delr1[3],delr2[3],fj[3],fk[3];
+  int *ilist,*jlist,*numneigh,**firstneigh;
+
+  evdwl = 0.0;
+  ev_init(eflag,vflag);
+
+  double **x = atom->x;
+  double **f = atom->f;
+  tagint *tag = atom->tag;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+  int newton_pair = force->newton_pair;
+  const flt_t cutshortsq = r0max*r0max;
+
+  // convert coordinates of owned and ghost atoms once per step
+
+  if (atom->nmax > nmax) {
+    memory->destroy(xf);
+    nmax = atom->nmax;
+    memory->create(xf,4*nmax,"pair:xf");
+  }
+  for (i = 0; i < nall; i++) {
+    xf[4*i] = x[i][0];
+    xf[4*i+1] = x[i][1];
+    xf[4*i+2] = x[i][2];
+    xf[4*i+3] = 0.0;
+  }
+
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  acc_t fxtmp,fytmp,fztmp;
+
+  // loop over full neighbor list of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    itag = tag[i];
+    itype = map[type[i]];
+    xtmp = xf[4*i];
+    ytmp = xf[4*i+1];
+    ztmp = xf[4*i+2];
+    fxtmp = fytmp = fztmp = 0.0;
+
+    // two-body interactions, skip half of them
+
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    int numshort = 0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+
+      delx = xtmp - xf[4*j];
+      dely = ytmp - xf[4*j+1];
+      delz = ztmp - xf[4*j+2];
+      rsq = delx*delx + dely*dely + delz*delz;
+
+      if (rsq < cutshortsq) {
+        neighshort[numshort++] = j;
+        if (numshort >= maxshort) {
+          maxshort += maxshort/2;
+          memory->grow(neighshort,maxshort,"pair:neighshort");
+        }
+      }
+
+      // ties are broken with the double precision coordinates
+
+      jtag = tag[j];
+      if (itag > jtag) {
+        if ((itag+jtag) % 2 == 0) continue;
+      } else if (itag < jtag) {
+        if ((itag+jtag) % 2 == 1) continue;
+      } else {
+        if (x[j][2] < x[i][2]) continue;
+        if (x[j][2] == x[i][2] && x[j][1] < x[i][1]) continue;
+        if (x[j][2] == x[i][2] && x[j][1] == x[i][1] && x[j][0] < x[i][0]) continue;
+      }
+
+      jtype = map[type[j]];
+      ijparam = elem3param[itype][jtype][jtype];
+      if (rsq >= fparams[ijparam].cutsq) continue;
+
+      twobody_flt(fparams[ijparam],rsq,fpair,eflag,evdwl);
+
+      fxtmp += delx*fpair;
+      fytmp += dely*fpair;
+      fztmp += delz*fpair;
+      f[j][0] -= delx*fpair;
+      f[j][1] -= dely*fpair;
+      f[j][2] -= delz*fpair;
+
+      if (evflag) ev_tally(i,j,nlocal,newton_pair,
+                           evdwl,0.0,fpair,delx,dely,delz);
+    }
+
+    jnumm1 = numshort - 1;
+
+    for (jj = 0; jj < jnumm1; jj++) {
+      j = neighshort[jj];
+      jtype = map[type[j]];
+      ijparam = elem3param[itype][jtype][jtype];
+      delr1[0] = xf[4*j] - xtmp;
+      delr1[1] = xf[4*j+1] - ytmp;
+      delr1[2] = xf[4*j+2] - ztmp;
+      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
+      if (rsq1 >= fparams[ijparam].cutsq2) continue;
+
+      acc_t fjxtmp,fjytmp,fjztmp;
+      fjxtmp = fjytmp = fjztmp = 0.0;
+
+      for (kk = jj+1; kk < numshort; kk++) {
+        k = neighshort[kk];
+        ktype = map[type[k]];
+        ikparam = elem3param[itype][ktype][ktype];
+        ijkparam = elem3param[itype][jtype][ktype];
+
+        delr2[0] = xf[4*k] - xtmp;
+        delr2[1] = xf[4*k+1] - ytmp;
+        delr2[2] = xf[4*k+2] - ztmp;
+        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
+        if (rsq2 >= fparams[ikparam].cutsq2) continue;
+
+        threebody_flt(fparams[ijparam],fparams[ikparam],fparams[ijkparam],
+                      rsq1,rsq2,delr1,delr2,fj,fk,eflag,evdwl);
+
+        fxtmp -= fj[0] + fk[0];
+        fytmp -= fj[1] + fk[1];
+        fztmp -= fj[2] + fk[2];
+        fjxtmp += fj[0];
+        fjytmp += fj[1];
+        fjztmp += fj[2];
+        f[k][0] += fk[0];
+        f[k][1] += fk[1];
+        f[k][2] += fk[2];
+
+        if (evflag) {
+          double fjd[3] = {fj[0],fj[1],fj[2]}, fkd[3] = {fk[0],fk[1],fk[2]};
+          double delr1d[3] = {delr1[0],delr1[1],delr1[2]};
+          double delr2d[3] = {delr2[0],delr2[1],delr2[2]};
+          ev_tally3(i,j,k,evdwl,0.0,fjd,fkd,delr1d,delr2d);
+        }
+      }
+      f[j][0] += fjxtmp;
+      f[j][1] += fjytmp;
+      f[j][2] += fjztmp;
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   convert parameters to flt_t after the parent has derived them
+------------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairVashishtaPrecision<flt_t,acc_t>::setup_params()
+{
+  PairVashishta::setup_params();
+
+  memory->destroy(fparams);
+  memory->create(fparams,nparams,"pair:fparams");
+
+  for (int m = 0; m < nparams; m++) {
+    fparams[m].bigb = params[m].bigb;
+    fparams[m].gamma = params[m].gamma;
+    fparams[m].r0 = params[m].r0;
+    fparams[m].bigc = params[m].bigc;
+    fparams[m].costheta = params[m].costheta;
+    fparams[m].big2b = params[m].big2b;
+    fparams[m].bigh = params[m].bigh;
+    fparams[m].eta = params[m].eta;
+    fparams[m].lam1inv = params[m].lam1inv;
+    fparams[m].lam4inv = params[m].lam4inv;
+    fparams[m].zizj = params[m].zizj;
+    fparams[m].mbigd = params[m].mbigd;
+    fparams[m].bigw = params[m].bigw;
+    fparams[m].heta = params[m].heta;
+    fparams[m].big6w = params[m].big6w;
+    fparams[m].dvrc = params[m].dvrc;
+    fparams[m].c0 = params[m].c0;
+    fparams[m].cutsq2 = params[m].cutsq2;
+    fparams[m].cutsq = params[m].cutsq;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairVashishtaPrecision<flt_t,acc_t>::twobody_flt(const ParamT &param, flt_t rsq,
+                                                      flt_t &fforce, int eflag, flt_t &eng)
+{
+  flt_t r,rinvsq,r4inv,r6inv,reta,lam1r,lam4r,vc2,vc3;
+
+  r = std::sqrt(rsq);
+  rinvsq = flt_t(1.0)/rsq;
+  r4inv = rinvsq*rinvsq;
+  r6inv = rinvsq*r4inv;
+  reta = std::pow(r,-param.eta);
+  lam1r = r*param.lam1inv;
+  lam4r = r*param.lam4inv;
+  vc2 = param.zizj * std::exp(-lam1r)/r;
+  vc3 = param.mbigd * r4inv*std::exp(-lam4r);
+
+  fforce = (param.dvrc*r
+            - (flt_t(4.0)*vc3 + lam4r*vc3+param.big6w*r6inv
+               - param.heta*reta - vc2 - lam1r*vc2)
+            ) * rinvsq;
+  if (eflag) eng = param.bigh*reta
+               + vc2 - vc3 - param.bigw*r6inv
+               - r*param.dvrc + param.c0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairVashishtaPrecision<flt_t,acc_t>::threebody_flt(const ParamT &paramij,
+                                                        const ParamT &paramik,
+                                                        const ParamT &paramijk,
+                                                        flt_t rsq1, flt_t rsq2,
+                                                        flt_t *delr1, flt_t *delr2,
+                                                        flt_t *fj, flt_t *fk, int eflag,
+                                                        flt_t &eng)
+{
+  flt_t r1,rinvsq1,rainv1,gsrainv1,gsrainvsq1,expgsrainv1;
+  flt_t r2,rinvsq2,rainv2,gsrainv2,gsrainvsq2,expgsrainv2;
+  flt_t rinv12,cs,delcs,delcssq,facexp,facrad,frad1,frad2,pcsinv,pcsinvsq,pcs;
+  flt_t facang,facang12,csfacang,csfac1,csfac2;
+
+  r1 = std::sqrt(rsq1);
+  rinvsq1 = flt_t(1.0)/rsq1;
+  rainv1 = flt_t(1.0)/(r1 - paramij.r0);
+  gsrainv1 = paramij.gamma * rainv1;
+  gsrainvsq1 = gsrainv1*rainv1/r1;
+  expgsrainv1 = exp_cut(gsrainv1);
+
+  r2 = std::sqrt(rsq2);
+  rinvsq2 = flt_t(1.0)/rsq2;
+  rainv2 = flt_t(1.0)/(r2 - paramik.r0);
+  gsrainv2 = paramik.gamma * rainv2;
+  gsrainvsq2 = gsrainv2*rainv2/r2;
+  expgsrainv2 = exp_cut(gsrainv2);
+
+  rinv12 = flt_t(1.0)/(r1*r2);
+  cs = (delr1[0]*delr2[0] + delr1[1]*delr2[1] + delr1[2]*delr2[2]) * rinv12;
+  delcs = cs - paramijk.costheta;
+  delcssq = delcs*delcs;
+  pcsinv = paramijk.bigc*delcssq + flt_t(1.0);
+  pcsinvsq = pcsinv*pcsinv;
+  pcs = delcssq/pcsinv;
+
+  facexp = expgsrainv1*expgsrainv2;
+
+  facrad = paramijk.bigb * facexp * pcs;
+  frad1 = facrad*gsrainvsq1;
+  frad2 = facrad*gsrainvsq2;
+  facang = paramijk.big2b * facexp * delcs/pcsinvsq;
+  facang12 = rinv12*facang;
+  csfacang = cs*facang;
+  csfac1 = rinvsq1*csfacang;
+
+  fj[0] = delr1[0]*(frad1+csfac1)-delr2[0]*facang12;
+  fj[1] = delr1[1]*(frad1+csfac1)-delr2[1]*facang12;
+  fj[2] = delr1[2]*(frad1+csfac1)-delr2[2]*facang12;
+
+  csfac2 = rinvsq2*csfacang;
+
+  fk[0] = delr2[0]*(frad2+csfac2)-delr1[0]*facang12;
+  fk[1] = delr2[1]*(frad2+csfac2)-delr1[1]*facang12;
+  fk[2] = delr2[2]*(frad2+csfac2)-delr1[2]*facang12;
+
+  if (eflag) eng = facrad;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+double PairVashishtaPrecision<flt_t,acc_t>::memory_usage()
+{
+  double bytes = Pair::memory_usage();
+  bytes += (double)maxshort*sizeof(int);
+  bytes += (double)4*nmax*sizeof(flt_t);
+  bytes += (double)nparams*sizeof(ParamT);
+  return bytes;
+}
+
+/* ---------------------------------------------------------------------- */
+
+namespace LAMMPS_NS {
+template class PairVashishtaPrecision<float,double>;
+template class PairVashishtaPrecision<float,float>;
+}
@@ -0,0 +1,364 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   vectorizable variant of pair style vashishta
+
+   the neighbors of each atom are gathered into structure-of-arrays
+   tiles and the two-body and three-body terms are evaluated in loops
+   without branches or calls, so the compiler can map them onto SIMD
+   lanes. cutoffs are applied by masking instead of skipping.
+   the exponential radial factor of the three-body term only depends
+   on the I-J pair, so it is computed once per short neighbor instead
+   of once per triplet. arithmetic and summation order are the same as
+   in pair style vashishta.
+------------------------------------------------------------------------- */
+
+#include "pair_vashishta_simd.h"
+
+#include "atom.h"
+#include "force.h"
+#include "memory.h"
+#include "neigh_list.h"
+
+#include <cmath>
+
+using namespace LAMMPS_NS;
+
+// request SIMD code generation for the lane loops where supported,
+// e.g. compile with -DUSE_OMP_SIMD -fopenmp-simd
+
+#if defined(USE_OMP_SIMD)
+#define VASHISHTA_SIMD _Pragma("omp simd")
+#else
+#define VASHISHTA_SIMD
+#endif
+
+/* ---------------------------------------------------------------------- */
+
+PairVashishtaSIMD::PairVashishtaSIMD(LAMMPS *lmp) : PairVashishta(lmp)
+{
+  shortlist_support = 0;
+  maxtile = 0;
+  dtile = nullptr;
+  itile = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairVashishtaSIMD::~PairVashishtaSIMD()
+{
+  if (copymode) return;
+
+  memory->destroy(dtile);
+  memory->destroy(itile);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairVashishtaSIMD::compute(int eflag, int vflag)
+{
+  int i,j,k,ii,jj,kk,n,inum,jnum;
+  int itype,jtype,ijparam;
+  tagint itag,jtag;
+  double xtmp,ytmp,ztmp,delx,dely,delz,fpair;
+  double delr1[3],delr2[3],fj[3],fk[3];
+  int *ilist,*jlist,*numneigh,**firstneigh;
+
+  ev_init(eflag,vflag);
+
+  double **x = atom->x;
+  double **f = atom->f;
+  tagint *tag = atom->tag;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  int newton_pair = force->newton_pair;
+  const double cutshortsq = r0max*r0max;
+  const Param * _noalias const prm = params;
+
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  double fxtmp,fytmp,fztmp;
+
+  // loop over full neighbor list of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    itag = tag[i];
+    itype = map[type[i]];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    fxtmp = fytmp = fztmp = 0.0;
+
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    if (jnum > maxtile) grow_tiles(jnum);
+
+    double * _noalias const dx = dtile[DX];
+    double * _noalias const dy = dtile[DY];
+    double * _noalias const dz = dtile[DZ];
+    double * _noalias const drsq = dtile[RSQ];
+    int * _noalias const jidx = itile[JIDX];
+
+    // gather neighbor coordinates into the tile
+
+    for (jj = 0; jj < jnum; jj++) jidx[jj] = jlist[jj] & NEIGHMASK;
+
+    VASHISHTA_SIMD
+    for (jj = 0; jj < jnum; jj++) {
+      const double *xj = x[jidx[jj]];
+      dx[jj] = xtmp - xj[0];
+      dy[jj] = ytmp - xj[1];
+      dz[jj] = ztmp - xj[2];
+      drsq[jj] = dx[jj]*dx[jj] + dy[jj]*dy[jj] + dz[jj]*dz[jj];
+    }
+
+    // compact the neighbors into the short list for the three-body term
+    // and into the half of the pairs that this atom computes.
+    // the selection is done with masks, since the tag parity test is a
+    // coin flip for the branch predictor. the sign of the tile deltas is
+    // the same as comparing coordinates, which resolves periodic images of I.
+
+    int * _noalias const pidx = itile[PAIR];
+    int * _noalias const pparam = itile[PPARAM];
+    int * _noalias const sidx = itile[SHORT];
+    int * _noalias const selem = itile[SELEM];
+    const int * const ijjparam = elem3param[itype][0];
+    const int ijjstride = nelements + 1;    // elem3param is contiguous, [itype][j][j]
+    int npair = 0;
+    int numshort = 0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jidx[jj];
+      jtype = map[type[j]];
+      jtag = tag[j];
+      ijparam = ijjparam[jtype*ijjstride];
+
+      const int odd = (itag+jtag) & 1;
+      const int above = (dz[jj] < 0.0) || ((dz[jj] == 0.0) &&
+                        ((dy[jj] < 0.0) || ((dy[jj] == 0.0) && (dx[jj] <= 0.0))));
+      const int half = (itag > jtag) ? odd : ((itag < jtag) ? !odd : above);
+
+      sidx[numshort] = j;
+      selem[numshort] = jtype;
+      numshort += (drsq[jj] < cutshortsq);
+
+      pidx[npair] = jj;
+      pparam[npair] = ijparam;
+      npair += half & (drsq[jj] < prm[ijparam].cutsq);
+    }
+
+    // two-body interactions over SIMD lanes
+
+    double * _noalias const tfpair = dtile[FPAIR];
+    double * _noalias const tepair = dtile[EPAIR];
+
+    VASHISHTA_SIMD
+    for (n = 0; n < npair; n++) {
+      const Param &p = prm[pparam[n]];
+      const double rsq = drsq[pidx[n]];
+      const double r = sqrt(rsq);
+      const double rinvsq = 1.0/rsq;
+      const double r4inv = rinvsq*rinvsq;
+      const double r6inv = rinvsq*r4inv;
+      const double reta = pow(r,-p.eta);
+      const double lam1r = r*p.lam1inv;
+      const double lam4r = r*p.lam4inv;
+      const double vc2 = p.zizj * exp(-lam1r)/r;
+      const double vc3 = p.mbigd * r4inv*exp(-lam4r);
+
+      tfpair[n] = (p.dvrc*r
+                   - (4.0*vc3 + lam4r*vc3+p.big6w*r6inv
+                      - p.heta*reta - vc2 - lam1r*vc2)
+                   ) * rinvsq;
+      tepair[n] = eflag ? p.bigh*reta + vc2 - vc3 - p.bigw*r6inv - r*p.dvrc + p.c0 : 0.0;
+    }
+
+    for (n = 0; n < npair; n++) {
+      jj = pidx[n];
+      j = jidx[jj];
+      delx = dx[jj];
+      dely = dy[jj];
+      delz = dz[jj];
+      fpair = tfpair[n];
+
+      fxtmp += delx*fpair;
+      fytmp += dely*fpair;
+      fztmp += delz*fpair;
+      f[j][0] -= delx*fpair;
+      f[j][1] -= dely*fpair;
+      f[j][2] -= delz*fpair;
+
+      if (evflag) ev_tally(i,j,nlocal,newton_pair,
+                           tepair[n],0.0,fpair,delx,dely,delz);
+    }
+
+    // radial factors of the three-body term for each short neighbor,
+    // zero outside the three-body cutoff of the I-J pair.
+    // not needed if there is no triplet.
+
+    double * _noalias const sdx = dtile[SDX];
+    double * _noalias const sdy = dtile[SDY];
+    double * _noalias const sdz = dtile[SDZ];
+    double * _noalias const sr = dtile[SR];
+    double * _noalias const sexp = dtile[EXPR];
+    double * _noalias const sgs = dtile[GSR];
+    double * _noalias const srinvsq = dtile[RINVSQ];
+    const int nradial = (numshort > 1) ? numshort : 0;
+
+    VASHISHTA_SIMD
+    for (n = 0; n < nradial; n++) {
+      const double *xj = x[sidx[n]];
+      const Param &p = prm[ijjparam[selem[n]*ijjstride]];
+      sdx[n] = xj[0] - xtmp;
+      sdy[n] = xj[1] - ytmp;
+      sdz[n] = xj[2] - ztmp;
+      const double rsq = sdx[n]*sdx[n] + sdy[n]*sdy[n] + sdz[n]*sdz[n];
+      const double r = sqrt(rsq);
+      const double rainv = 1.0/(r - p.r0);
+      const double gsrainv = p.gamma * rainv;
+      const bool inside = rsq < p.cutsq2;
+      sr[n] = r;
+      srinvsq[n] = 1.0/rsq;
+      sgs[n] = inside ? gsrainv*rainv/r : 0.0;
+      sexp[n] = inside ? exp(gsrainv) : 0.0;
+    }
+
+    // three-body interactions, partners K of each J over SIMD lanes
+
+    double * _noalias const tfjx = dtile[FJX];
+    double * _noalias const tfjy = dtile[FJY];
+    double * _noalias const tfjz = dtile[FJZ];
+    double * _noalias const tfkx = dtile[FKX];
+    double * _noalias const tfky = dtile[FKY];
+    double * _noalias const tfkz = dtile[FKZ];
+    double * _noalias const te3 = dtile[E3];
+
+    // a zero radial factor marks pairs outside the cutoff.
+    // it can also be the result of an underflow, those triplets contribute nothing
+
+    for (jj = 0; jj < numshort-1; jj++) {
+      if (sexp[jj] == 0.0) continue;
+      j = sidx[jj];
+      const int * const ijkparam = elem3param[itype][selem[jj]];
+      delr1[0] = sdx[jj];
+      delr1[1] = sdy[jj];
+      delr1[2] = sdz[jj];
+      const double r1 = sr[jj];
+      const double rinvsq1 = srinvsq[jj];
+      const double gsrainvsq1 = sgs[jj];
+      const double expgsrainv1 = sexp[jj];
+
+      VASHISHTA_SIMD
+      for (kk = jj+1; kk < numshort; kk++) {
+        const Param &p = prm[ijkparam[selem[kk]]];
+        const double r2 = sr[kk];
+        const double rinv12 = 1.0/(r1*r2);
+        const double cs = (delr1[0]*sdx[kk] + delr1[1]*sdy[kk] + delr1[2]*sdz[kk]) * rinv12;
+        const double delcs = cs - p.costheta;
+        const double delcssq = delcs*delcs;
+        const double pcsinv = p.bigc*delcssq + 1.0;
+        const double pcsinvsq = pcsinv*pcsinv;
+        const double pcs = delcssq/pcsinv;
+
+        const double facexp = expgsrainv1*sexp[kk];
+
+        const double facrad = p.bigb * facexp * pcs;
+        const double frad1 = facrad*gsrainvsq1;
+        const double frad2 = facrad*sgs[kk];
+        const double facang = p.big2b * facexp * delcs/pcsinvsq;
+        const double facang12 = rinv12*facang;
+        const double csfacang = cs*facang;
+        const double csfac1 = rinvsq1*csfacang;
+
+        tfjx[kk] = delr1[0]*(frad1+csfac1)-sdx[kk]*facang12;
+        tfjy[kk] = delr1[1]*(frad1+csfac1)-sdy[kk]*facang12;
+        tfjz[kk] = delr1[2]*(frad1+csfac1)-sdz[kk]*facang12;
+
+        const double csfac2 = srinvsq[kk]*csfacang;
+
+        tfkx[kk] = sdx[kk]*(frad2+csfac2)-delr1[0]*facang12;
+        tfky[kk] = sdy[kk]*(frad2+csfac2)-delr1[1]*facang12;
+        tfkz[kk] = sdz[kk]*(frad2+csfac2)-delr1[2]*facang12;
+        te3[kk] = facrad;
+      }
+
+      double fjxtmp,fjytmp,fjztmp;
+      fjxtmp = fjytmp = fjztmp = 0.0;
+
+      for (kk = jj+1; kk < numshort; kk++) {
+        if (sexp[kk] == 0.0) continue;
+        k = sidx[kk];
+        fj[0] = tfjx[kk];
+        fj[1] = tfjy[kk];
+        fj[2] = tfjz[kk];
+        fk[0] = tfkx[kk];
+        fk[1] = tfky[kk];
+        fk[2] = tfkz[kk];
+
+        fxtmp -= fj[0] + fk[0];
+        fytmp -= fj[1] + fk[1];
+        fztmp -= fj[2] + fk[2];
+        fjxtmp += fj[0];
+        fjytmp += fj[1];
+        fjztmp += fj[2];
+        f[k][0] += fk[0];
+        f[k][1] += fk[1];
+        f[k][2] += fk[2];
+
+        if (evflag) {
+          delr2[0] = sdx[kk];
+          delr2[1] = sdy[kk];
+          delr2[2] = sdz[kk];
+          ev_tally3(i,j,k,te3[kk],0.0,fj,fk,delr1,delr2);
+        }
+      }
+      f[j][0] += fjxtmp;
+      f[j][1] += fjytmp;
+      f[j][2] += fjztmp;
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   grow the work tiles to hold at least N neighbors
+------------------------------------------------------------------------- */
+
+void PairVashishtaSIMD::grow_tiles(int n)
+{
+  maxtile = n + n/2;
+  memory->destroy(dtile);
+  memory->destroy(itile);
+  memory->create(dtile,NDTILE,maxtile,"pair:dtile");
+  memory->create(itile,NITILE,maxtile,"pair:itile");
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairVashishtaSIMD::memory_usage()
+{
+  double bytes = Pair::memory_usage();
+  bytes += (double)NDTILE*maxtile*sizeof(double);
+  bytes += (double)NITILE*maxtile*sizeof(int);
+  return bytes;
+}
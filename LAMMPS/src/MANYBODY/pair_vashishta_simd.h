@@ -0,0 +1,57 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(vashishta/simd,PairVashishtaSIMD);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_VASHISHITA_SIMD_H
+#define LMP_PAIR_VASHISHITA_SIMD_H
+
+#include "pair_vashishta.h"
+
+namespace LAMMPS_NS {
+
+class PairVashishtaSIMD : public PairVashishta {
+ public:
+  PairVashishtaSIMD(class LAMMPS *);
+  ~PairVashishtaSIMD() override;
+  void compute(int, int) override;
+  double memory_usage() override;
+
+ protected:
+  // per-neighbor structure-of-arrays work tiles of one atom I
+  enum {
+    DX, DY, DZ, RSQ,     // all neighbors: I - J and squared distance
+    FPAIR, EPAIR,        // two-body neighbors: force and energy
+    SDX, SDY, SDZ, SR,   // short neighbors: J - I and distance
+    EXPR, GSR, RINVSQ,   // short neighbors: radial factors of the three-body term
+    FJX, FJY, FJZ,       // partners K of one J: three-body forces
+    FKX, FKY, FKZ, E3,
+    NDTILE
+  };
+  enum { JIDX, PAIR, PPARAM, SHORT, SELEM, NITILE };
+
+  int maxtile;       // length of each tile
+  double **dtile;    // NDTILE x maxtile
+  int **itile;       // NITILE x maxtile
+
+  void grow_tiles(int);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -39,9 +39,18 @@ class PairVashishtaTable : public PairVashishta {
   double ***forceTable;        // table of forces per element pair
   double ***potentialTable;    // table of potential energies
 
+  int ntable3;                 // points in three-body tables, 0 = analytic
+  double **deltaR3;            // three-body table spacing in r per element pair
+  double **oneOverDeltaR3;
+  double ***expTable;          // exp(gamma/(r-r0)) per element pair
+  double ***dexpTable;         // exp(gamma/(r-r0))*gamma/(r-r0)^2
+
   void twobody_table(const Param &, double, double &, int, double &);
+  void threebody_table(const Param &, const Param &, const Param &, double, double,
+                       double *, double *, double *, double *, int, double &);
   void setup_params() override;
   void create_tables();
+  void create_threebody_tables();
 };
 
 }    // namespace LAMMPS_NS
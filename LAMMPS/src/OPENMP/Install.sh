@@ -47,6 +47,8 @@ action thr_omp.h
 action thr_omp.cpp
 action thr_data.h
 action thr_data.cpp
+action thr_sched.h
+action thr_sched.cpp
 
 # step 2: handle cases and tasks not handled in step 1
 
@@ -19,6 +19,7 @@
 
 #include "fix_omp.h"
 #include "thr_data.h"
+#include "thr_omp.h"
 
 #include "atom.h"
 #include "comm.h"
@@ -34,6 +35,7 @@
 #include "dihedral_hybrid.h"
 #include "improper_hybrid.h"
 #include "kspace.h"
+#include "thr_sched.h"
 
 #include <cstring>
 
@@ -61,9 +63,10 @@ static int get_tid()
 
 FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
   :  Fix(lmp, narg, arg),
-     thr(nullptr), last_omp_style(nullptr), last_pair_hybrid(nullptr),
+     thr(nullptr), sched(nullptr), last_omp_style(nullptr), last_pair_hybrid(nullptr),
      _nthr(-1), _neighbor(true), _mixed(false), _reduced(true),
-     _pair_compute_flag(false), _kspace_compute_flag(false)
+     _pair_compute_flag(false), _kspace_compute_flag(false), _reduce_mode(REDUCE_BLOCK),
+     _reduce_block(false), _fclear_nall(-1), _fclear_f(nullptr)
 {
   if (narg < 4) error->all(FLERR,"Illegal package omp command");
 
@@ -92,6 +95,8 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
     comm->nthreads = nthreads;
   }
 
+  sched = new ThrSched;
+
   // optional keywords
 
   int iarg = 4;
@@ -100,6 +105,19 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
       _neighbor = utils::logical(FLERR,arg[iarg+1],false,lmp) != 0;
       iarg += 2;
+    } else if (strcmp(arg[iarg],"sched") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
+      if (strcmp(arg[iarg+1],"static") == 0) sched->set_steal(false);
+      else if (strcmp(arg[iarg+1],"steal") == 0) sched->set_steal(true);
+      else error->all(FLERR,"Illegal package omp command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"reduce") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
+      if (strcmp(arg[iarg+1],"full") == 0) _reduce_mode = REDUCE_FULL;
+      else if (strcmp(arg[iarg+1],"block") == 0) _reduce_mode = REDUCE_BLOCK;
+      else if (strcmp(arg[iarg+1],"atomic") == 0) _reduce_mode = REDUCE_ATOMIC;
+      else error->all(FLERR,"Illegal package omp command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal package omp command");
   }
 
@@ -112,6 +130,8 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
     if (reset_thr)
       utils::logmesg(lmp, "set {} OpenMP thread(s) per MPI task\n", nthreads);
     utils::logmesg(lmp, "using {} neighbor list subroutines\n", nmode);
+    if (sched->get_steal())
+      utils::logmesg(lmp, "using work-stealing loop scheduling\n");
 #else
     error->warning(FLERR,"OpenMP support not enabled during compilation; "
                          "using 1 thread only.");
@@ -142,6 +162,7 @@ FixOMP::~FixOMP()
     delete thr[i];
 
   delete[] thr;
+  delete sched;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -279,12 +300,27 @@ void FixOMP::init()
 #undef CheckHybridForOMP
   neighbor->set_omp_neighbor(_neighbor ? 1 : 0);
 
+  // forces can be reduced by blocks of touched atoms only if a single,
+  // non-hybrid pair style is the only /omp style writing forces and it
+  // only writes to atoms of its neighbor list. not supported with r-RESPA
+
+  _reduce_block = false;
+  if ((_reduce_mode != REDUCE_FULL) && last_omp_style && (last_omp_style == force->pair)
+      && !last_pair_hybrid && !utils::strmatch(update->integrate_style,"^respa")) {
+    auto pair = dynamic_cast<ThrOMP *>(force->pair);
+    if (pair && pair->get_fmask_flag()) _reduce_block = true;
+  }
+  _fclear_nall = -1;
+
   // diagnostic output
   if (comm->me == 0) {
     if (last_omp_style) {
       if (last_pair_hybrid)
         utils::logmesg(lmp,"Hybrid pair style last /omp style {}\n",last_hybrid_name);
       utils::logmesg(lmp,"Last active /omp style is {}_style {}\n",last_force_name,last_omp_name);
+      if (_reduce_block)
+        utils::logmesg(lmp,"Reducing forces by touched blocks{}\n",
+                       (_reduce_mode == REDUCE_ATOMIC) ? " with atomic adds" : "");
     } else {
       utils::logmesg(lmp,"No /omp style for force computation currently active\n");
     }
@@ -313,13 +349,22 @@ void FixOMP::pre_force(int)
   double *desph = atom->desph;
   double *drho = atom->drho;
 
+  // the block-wise reduction zeroes all blocks it touched. the per thread
+  // forces only need a full clear after reneighboring, when the force
+  // array was reallocated, or when the last step was not reduced.
+
+  const bool fclear = !_reduce_block || !_reduced || (neighbor->ago == 0)
+    || (nall != _fclear_nall) || (f != _fclear_f);
+  _fclear_nall = nall;
+  _fclear_f = f;
+
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(f,torque,erforce,desph,drho)
 #endif
   {
     const int tid = get_tid();
     thr[tid]->check_tid(tid);
-    thr[tid]->init_force(nall,f,torque,erforce,desph,drho);
+    thr[tid]->init_force(nall,f,torque,erforce,desph,drho,fclear);
   } // end of omp parallel region
 
   _reduced = false;
@@ -25,6 +25,7 @@ FixStyle(OMP,FixOMP);
 namespace LAMMPS_NS {
 
 class ThrData;
+class ThrSched;
 
 class FixOMP : public Fix {
   friend class ThrOMP;
@@ -49,6 +50,7 @@ class FixOMP : public Fix {
 
  protected:
   ThrData **thr;
+  ThrSched *sched;    // loop scheduler shared by threaded styles
   void *last_omp_style;      // pointer to the style that needs
                              // to do the general force reduction
   void *last_pair_hybrid;    // pointer to the pair style that needs
@@ -58,11 +60,16 @@ class FixOMP : public Fix {
 
  public:
   ThrData *get_thr(int tid) { return thr[tid]; }
+  ThrSched *get_sched() { return sched; }
   int get_nthr() const { return _nthr; }
 
   bool get_neighbor() const { return _neighbor; }
   bool get_mixed() const { return _mixed; }
   bool get_reduced() const { return _reduced; }
+  bool get_reduce_block() const { return _reduce_block; }
+  bool get_reduce_atomic() const { return _reduce_mode == REDUCE_ATOMIC; }
+
+  enum { REDUCE_FULL, REDUCE_BLOCK, REDUCE_ATOMIC };
 
  private:
   int _nthr;                    // number of currently active ThrData objects
@@ -71,6 +78,10 @@ class FixOMP : public Fix {
   bool _reduced;                // whether forces have been reduced for this step
   bool _pair_compute_flag;      // whether pair_compute is called
   bool _kspace_compute_flag;    // whether kspace_compute is called
+  int _reduce_mode;             // requested force reduction strategy
+  bool _reduce_block;           // whether forces are reduced by marked blocks
+  int _fclear_nall;             // nall at the time of the last force reduction
+  double **_fclear_f;           // force array at the time of the last force reduction
 };
 
 }    // namespace LAMMPS_NS
@@ -31,6 +31,7 @@ PairLJCutOMP::PairLJCutOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  thr_fmask_flag = 1;
   cut_respa = nullptr;
 }
 
@@ -33,6 +33,7 @@ PairMorseOMP::PairMorseOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  thr_fmask_flag = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -254,7 +254,7 @@ void PairReaxFFOMP::compute(int eflag, int vflag)
   // Why not update workspace like in MPI-only code?
   // Using the MPI-only way messes up the hb energy
   //workspace->realloc.num_far = write_reax_lists();
-  write_reax_lists();
+  Set_List_Top(write_reax_lists(), api->lists+FAR_NBRS);
 
   // forces
 
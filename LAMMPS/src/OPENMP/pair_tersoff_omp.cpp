@@ -35,6 +35,7 @@ PairTersoffOMP::PairTersoffOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  thr_fmask_flag = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -46,6 +47,8 @@ void PairTersoffOMP::compute(int eflag, int vflag)
   const int nall = atom->nlocal + atom->nghost;
   const int nthreads = comm->nthreads;
   const int inum = list->inum;
+  ThrSched * const sched = fix->get_sched();
+  sched->setup(inum, nthreads);
 
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
@@ -58,31 +61,37 @@ void PairTersoffOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
 
-    if (shift_flag) {
-      if (evflag) {
-        if (eflag) {
-          if (vflag_either) eval<1,1,1,1>(ifrom, ito, thr);
-          else eval<1,1,1,0>(ifrom, ito, thr);
-        } else {
-          if (vflag_either) eval<1,1,0,1>(ifrom, ito, thr);
-          else eval<1,1,0,0>(ifrom, ito, thr);
-        }
-      } else eval<1,0,0,0>(ifrom, ito, thr);
+    while (sched->next(tid, ifrom, ito)) {
+      if (shift_flag) {
+        if (evflag) {
+          if (eflag) {
+            if (vflag_either) eval<1,1,1,1>(ifrom, ito, thr);
+            else eval<1,1,1,0>(ifrom, ito, thr);
+          } else {
+            if (vflag_either) eval<1,1,0,1>(ifrom, ito, thr);
+            else eval<1,1,0,0>(ifrom, ito, thr);
+          }
+        } else eval<1,0,0,0>(ifrom, ito, thr);
 
-    } else {
+      } else {
 
-      if (evflag) {
-        if (eflag) {
-          if (vflag_either) eval<0,1,1,1>(ifrom, ito, thr);
-          else eval<0,1,1,0>(ifrom, ito, thr);
-        } else {
-          if (vflag_either) eval<0,1,0,1>(ifrom, ito, thr);
-          else eval<0,1,0,0>(ifrom, ito, thr);
-        }
-      } else eval<0,0,0,0>(ifrom, ito, thr);
+        if (evflag) {
+          if (eflag) {
+            if (vflag_either) eval<0,1,1,1>(ifrom, ito, thr);
+            else eval<0,1,1,0>(ifrom, ito, thr);
+          } else {
+            if (vflag_either) eval<0,1,0,1>(ifrom, ito, thr);
+            else eval<0,1,0,0>(ifrom, ito, thr);
+          }
+        } else eval<0,0,0,0>(ifrom, ito, thr);
+      }
     }
 
     thr->timer(Timer::PAIR);
+
+    // wait for the slowest thread, to measure load imbalance
+    sync_threads();
+    thr->timer(Timer::IDLE);
     reduce_thr(this, eflag, vflag, thr);
   } // end of omp parallel region
 }
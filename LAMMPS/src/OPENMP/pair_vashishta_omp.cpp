@@ -31,17 +31,27 @@ PairVashishtaOMP::PairVashishtaOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  thr_fmask_flag = 1;
 }
 
 /* ---------------------------------------------------------------------- */
 
 void PairVashishtaOMP::compute(int eflag, int vflag)
 {
+  // the half plus short full list variant has no threaded kernel
+
+  if (shortlist_flag) {
+    PairVashishta::compute(eflag,vflag);
+    return;
+  }
+
   ev_init(eflag,vflag);
 
   const int nall = atom->nlocal + atom->nghost;
   const int nthreads = comm->nthreads;
   const int inum = list->inum;
+  ThrSched * const sched = fix->get_sched();
+  sched->setup(inum, nthreads);
 
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
@@ -54,15 +64,21 @@ void PairVashishtaOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
 
-    if (evflag) {
-      if (eflag) {
-        eval<1,1>(ifrom, ito, thr);
-      } else {
-        eval<1,0>(ifrom, ito, thr);
-      }
-    } else eval<0,0>(ifrom, ito, thr);
+    while (sched->next(tid, ifrom, ito)) {
+      if (evflag) {
+        if (eflag) {
+          eval<1,1>(ifrom, ito, thr);
+        } else {
+          eval<1,0>(ifrom, ito, thr);
+        }
+      } else eval<0,0>(ifrom, ito, thr);
+    }
 
     thr->timer(Timer::PAIR);
+
+    // wait for the slowest thread, to measure load imbalance
+    sync_threads();
+    thr->timer(Timer::IDLE);
     reduce_thr(this, eflag, vflag, thr);
   } // end of omp parallel region
 }
@@ -31,6 +31,7 @@ PairVashishtaTableOMP::PairVashishtaTableOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  thr_fmask_flag = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -42,6 +43,8 @@ void PairVashishtaTableOMP::compute(int eflag, int vflag)
   const int nall = atom->nlocal + atom->nghost;
   const int nthreads = comm->nthreads;
   const int inum = list->inum;
+  ThrSched * const sched = fix->get_sched();
+  sched->setup(inum, nthreads);
 
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
@@ -54,15 +57,21 @@ void PairVashishtaTableOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
 
-    if (evflag) {
-      if (eflag) {
-        eval<1,1>(ifrom, ito, thr);
-      } else {
-        eval<1,0>(ifrom, ito, thr);
-      }
-    } else eval<0,0>(ifrom, ito, thr);
+    while (sched->next(tid, ifrom, ito)) {
+      if (evflag) {
+        if (eflag) {
+          eval<1,1>(ifrom, ito, thr);
+        } else {
+          eval<1,0>(ifrom, ito, thr);
+        }
+      } else eval<0,0>(ifrom, ito, thr);
+    }
 
     thr->timer(Timer::PAIR);
+
+    // wait for the slowest thread, to measure load imbalance
+    sync_threads();
+    thr->timer(Timer::IDLE);
     reduce_thr(this, eflag, vflag, thr);
   } // end of omp parallel region
 }
@@ -185,8 +194,12 @@ void PairVashishtaTableOMP::eval(int iifrom, int iito, ThrData * const thr)
         rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
         if (rsq2 >= params[ikparam].cutsq2) continue;
 
-        threebody(&params[ijparam],&params[ikparam],&params[ijkparam],
-                  rsq1,rsq2,delr1,delr2,fj,fk,EFLAG,evdwl);
+        if (ntable3)
+          threebody_table(params[ijparam],params[ikparam],params[ijkparam],
+                          rsq1,rsq2,delr1,delr2,fj,fk,EFLAG,evdwl);
+        else
+          threebody(&params[ijparam],&params[ikparam],&params[ijkparam],
+                    rsq1,rsq2,delr1,delr2,fj,fk,EFLAG,evdwl);
 
         fxtmp -= fj[0] + fk[0];
         fytmp -= fj[1] + fk[1];
@@ -46,6 +46,7 @@ static constexpr double EPS_HOC = 1.0e-7;
 PPPMOMP::PPPMOMP(LAMMPS *lmp) : PPPM(lmp), ThrOMP(lmp, THR_KSPACE)
 {
   triclinic_support = 1;
+  async_support = 0;
   suffix_flag |= Suffix::OMP;
 }
 
@@ -50,6 +50,7 @@ PPPMTIP4POMP::PPPMTIP4POMP(LAMMPS *lmp) :
   PPPMTIP4P(lmp), ThrOMP(lmp, THR_KSPACE)
 {
   triclinic_support = 1;
+  async_support = 0;
   suffix_flag |= Suffix::OMP;
 }
 
@@ -558,6 +558,8 @@ namespace ReaxFF {
     data->my_en.e_pen = total_Epen;
     data->my_en.e_coa = total_Ecoa;
 
+    Set_List_Top(num_thb_intrs, thb_intrs);
+
     if (num_thb_intrs >= thb_intrs->num_intrs * DANGER_ZONE) {
       workspace->realloc.num_3body = num_thb_intrs * TWICE;
       if (num_thb_intrs > thb_intrs->num_intrs)
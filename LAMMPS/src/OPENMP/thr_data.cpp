@@ -31,7 +31,8 @@ using namespace LAMMPS_NS;
 ThrData::ThrData(int tid, Timer *t) :
     _f(nullptr), _torque(nullptr), _erforce(nullptr), _de(nullptr), _drho(nullptr), _mu(nullptr),
     _lambda(nullptr), _rhoB(nullptr), _D_values(nullptr), _rho(nullptr), _fp(nullptr),
-    _rho1d(nullptr), _drho1d(nullptr), _rho1d_6(nullptr), _drho1d_6(nullptr), _tid(tid), _timer(t)
+    _rho1d(nullptr), _drho1d(nullptr), _rho1d_6(nullptr), _drho1d_6(nullptr), _fmask(nullptr),
+    _fmask_max(0), _nblock(0), _nmark(0), _fmask_stamp(-1), _fsparse(false), _tid(tid), _timer(t)
 {
   _timer_active = 0;
 }
@@ -69,7 +70,7 @@ double ThrData::get_time(enum Timer::ttype flag)
 /* ---------------------------------------------------------------------- */
 
 void ThrData::init_force(int nall, double **f, double **torque, double *erforce, double *de,
-                         double *drho)
+                         double *drho, bool fclear)
 {
   eng_vdwl = eng_coul = eng_bond = eng_angle = eng_dihed = eng_imprp = eng_kspce = 0.0;
   memset(virial_pair, 0, 6 * sizeof(double));
@@ -82,9 +83,12 @@ void ThrData::init_force(int nall, double **f, double **torque, double *erforce,
   eatom_pair = eatom_bond = eatom_angle = eatom_dihed = eatom_imprp = eatom_kspce = nullptr;
   vatom_pair = vatom_bond = vatom_angle = vatom_dihed = vatom_imprp = vatom_kspce = nullptr;
 
+  // the force reduction already zeroes the segments of threads > 0,
+  // so a full clear is only needed when the caller cannot rely on that
+
   if (nall >= 0 && f) {
     _f = f + _tid * nall;
-    memset(&(_f[0][0]), 0, nall * 3 * sizeof(double));
+    if (fclear || (_tid == 0)) memset(&(_f[0][0]), 0, nall * 3 * sizeof(double));
   } else
     _f = nullptr;
 
@@ -113,6 +117,20 @@ void ThrData::init_force(int nall, double **f, double **torque, double *erforce,
     _drho = nullptr;
 }
 
+/* ---------------------------------------------------------------------- */
+
+void ThrData::init_fmask(int nblock)
+{
+  if (nblock > _fmask_max) {
+    delete[] _fmask;
+    _fmask_max = nblock;
+    _fmask = new unsigned char[_fmask_max];
+  }
+  if (nblock > 0) memset(_fmask, 0, nblock);
+  _nblock = nblock;
+  _nmark = 0;
+}
+
 /* ----------------------------------------------------------------------
    set up and clear out locally managed per atom arrays
 ------------------------------------------------------------------------- */
@@ -268,6 +286,7 @@ double ThrData::memory_usage()
   double bytes = (7 + 6 * 6) * sizeof(double);
   bytes += (double) 2 * sizeof(double *);
   bytes += (double) 4 * sizeof(int);
+  bytes += (double) _fmask_max * sizeof(unsigned char);
 
   return bytes;
 }
@@ -365,3 +384,67 @@ void LAMMPS_NS::data_reduce_thr(double *dall, int nall, int nthreads, int ndim,
   return;
 #endif
 }
+
+/* ----------------------------------------------------------------------
+   reduce per thread forces into the first segment of the force array,
+   like data_reduce_thr(), but only visit the blocks of 1 << FBLOCK_SHIFT
+   atoms that a thread has marked in its mask. blocks are distributed
+   over threads, each thread sums the marked blocks of all dense threads
+   for its share. threads with only few marked blocks (_fsparse is set)
+   instead add their blocks with atomic operations in a second pass.
+   the masks of all threads must be complete before this is called.
+------------------------------------------------------------------------- */
+
+void LAMMPS_NS::force_reduce_thr(double *fall, int nall, int nthreads, ThrData **thr, int tid)
+{
+#if defined(_OPENMP)
+  // NOOP in single-threaded execution.
+  if (nthreads == 1) return;
+#pragma omp barrier
+  {
+    const int nvals = 3 * nall;
+    const int bsize = 3 << ThrData::FBLOCK_SHIFT;
+    const int nblock = (nall + (1 << ThrData::FBLOCK_SHIFT) - 1) >> ThrData::FBLOCK_SHIFT;
+    const int bdelta = nblock / nthreads + 1;
+    const int bfrom = (tid * bdelta > nblock) ? nblock : tid * bdelta;
+    const int bto = ((bfrom + bdelta) > nblock) ? nblock : (bfrom + bdelta);
+
+    bool sparse = false;
+    for (int n = 1; n < nthreads; ++n) sparse |= thr[n]->_fsparse;
+
+    for (int b = bfrom; b < bto; ++b) {
+      const int mfrom = b * bsize;
+      const int mto = ((mfrom + bsize) > nvals) ? nvals : (mfrom + bsize);
+      for (int n = 1; n < nthreads; ++n) {
+        if (thr[n]->_fsparse || !thr[n]->_fmask[b]) continue;
+        double *const fn = fall + n * nvals;
+        for (int m = mfrom; m < mto; ++m) {
+          fall[m] += fn[m];
+          fn[m] = 0.0;
+        }
+      }
+    }
+
+    if (sparse) {
+#pragma omp barrier
+      if (tid > 0 && thr[tid]->_fsparse) {
+        const unsigned char *const mask = thr[tid]->_fmask;
+        double *const fn = fall + tid * nvals;
+        for (int b = 0; b < nblock; ++b) {
+          if (!mask[b]) continue;
+          const int mfrom = b * bsize;
+          const int mto = ((mfrom + bsize) > nvals) ? nvals : (mfrom + bsize);
+          for (int m = mfrom; m < mto; ++m) {
+#pragma omp atomic
+            fall[m] += fn[m];
+            fn[m] = 0.0;
+          }
+        }
+      }
+    }
+  }
+#else
+  // NOOP in non-threaded execution.
+  return;
+#endif
+}
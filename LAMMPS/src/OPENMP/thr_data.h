@@ -28,11 +28,13 @@ namespace LAMMPS_NS {
 class ThrData {
   friend class FixOMP;
   friend class ThrOMP;
+  friend void force_reduce_thr(double *, int, int, ThrData **, int);
 
  public:
   ThrData(int tid, class Timer *t);
   ~ThrData()
   {
+    delete[] _fmask;
     delete _timer;
     _timer = nullptr;
   };
@@ -49,7 +51,23 @@ class ThrData {
   double get_time(enum Timer::ttype flag);
 
   // erase accumulator contents and hook up force arrays
-  void init_force(int, double **, double **, double *, double *, double *);
+  void init_force(int, double **, double **, double *, double *, double *, bool fclear = true);
+
+  // forces are reduced in blocks of 1 << FBLOCK_SHIFT atoms,
+  // i.e. three 64 byte cache lines per block
+  static constexpr int FBLOCK_SHIFT = 3;
+
+  // reset the record of per thread force blocks that may be non-zero
+  void init_fmask(int);
+  // record that this thread may have written the force of atom i
+  void mark_force(int i)
+  {
+    const int b = i >> FBLOCK_SHIFT;
+    if (!_fmask[b]) {
+      _fmask[b] = 1;
+      ++_nmark;
+    }
+  };
 
   // give access to per-thread offset arrays
   double **get_f() const { return _f; };
@@ -129,6 +147,15 @@ class ThrData {
   // this is for pppm/disp/omp
   void *_rho1d_6;
   void *_drho1d_6;
+
+  // blocks of the per thread force array that may be non-zero
+  unsigned char *_fmask;
+  int _fmask_max;         // allocated size of _fmask
+  int _nblock;            // number of blocks in use
+  int _nmark;             // number of marked blocks
+  bigint _fmask_stamp;    // neighbor list build the mask belongs to
+  bool _fsparse;          // true if this thread reduces with atomic adds
+
   // my thread id
   const int _tid;
   // timer info
@@ -146,7 +173,7 @@ class ThrData {
 
   // disabled default methods
  private:
-  ThrData() : _tid(-1), _timer(nullptr){};
+  ThrData() : _fmask(nullptr), _tid(-1), _timer(nullptr){};
 };
 
 ////////////////////////////////////////////////////////////////////////
@@ -154,5 +181,7 @@ class ThrData {
 ////////////////////////////////////////////////////////////////////////
 // generic per thread data reduction for continuous arrays of nthreads*nmax size
 void data_reduce_thr(double *, int, int, int, int);
+// force reduction restricted to the blocks marked by each thread
+void force_reduce_thr(double *, int, int, ThrData **, int);
 }    // namespace LAMMPS_NS
 #endif
@@ -29,6 +29,7 @@
 #include "improper.h"
 #include "math_const.h"
 #include "modify.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "pair.h"
 
@@ -41,9 +42,14 @@
 using namespace LAMMPS_NS;
 using MathConst::THIRD;
 
+// threads that marked less than this fraction of all force blocks
+// add their contributions with atomic operations instead
+static constexpr double FSPARSE_FRACTION = 0.125;
+
 /* ---------------------------------------------------------------------- */
 
-ThrOMP::ThrOMP(LAMMPS *ptr, int style) : lmp(ptr), fix(nullptr), thr_style(style), thr_error(0)
+ThrOMP::ThrOMP(LAMMPS *ptr, int style) :
+    lmp(ptr), fix(nullptr), thr_style(style), thr_error(0), thr_fmask_flag(0)
 {
   // register fix omp with this class
   fix = static_cast<FixOMP *>(lmp->modify->get_fix_by_id("package_omp"));
@@ -444,7 +450,10 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
 
   if (style == fix->last_omp_style) {
     if (need_force_reduce) {
-      data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
+      if (fix->get_reduce_block()) {
+        mark_force_thr((Pair *)style, nall, thr);
+        force_reduce_thr(&(f[0][0]), nall, nthreads, fix->thr, tid);
+      } else data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
       fix->did_reduce();
     }
 
@@ -454,6 +463,56 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
   thr->timer(Timer::COMM);
 }
 
+/* ----------------------------------------------------------------------
+   record the force blocks of atoms that this thread may have written to.
+   the mask for the thread's own range of the neighbor list only changes
+   when the list is rebuilt. ranges that the loop scheduler handed over
+   from other threads are added on top, so the mask may grow until the
+   next rebuild but always covers all non-zero blocks.
+   the master thread owns the reduction target and needs no mask.
+------------------------------------------------------------------------- */
+
+void ThrOMP::mark_force_thr(Pair * const pair, const int nall, ThrData * const thr)
+{
+  const int tid = thr->get_tid();
+  if (tid == 0) return;
+
+  const NeighList * const list = pair->list;
+  const int inum = list->inum;
+  const int * const ilist = list->ilist;
+  const int * const numneigh = list->numneigh;
+  int ** const firstneigh = list->firstneigh;
+  const int nblock = (nall + (1 << ThrData::FBLOCK_SHIFT) - 1) >> ThrData::FBLOCK_SHIFT;
+
+  auto mark_range = [&](int ifrom, int ito) {
+    if (ito > inum) ito = inum;
+    for (int ii = ifrom; ii < ito; ++ii) {
+      const int i = ilist[ii];
+      const int * const jlist = firstneigh[i];
+      const int jnum = numneigh[i];
+      thr->mark_force(i);
+      for (int jj = 0; jj < jnum; ++jj)
+        thr->mark_force(jlist[jj] & NEIGHMASK);
+    }
+  };
+
+  if ((thr->_fmask_stamp != lmp->neighbor->ncalls) || (thr->_nblock != nblock)) {
+    thr->init_fmask(nblock);
+    const int nthreads = lmp->comm->nthreads;
+    const int idelta = 1 + inum / nthreads;
+    const int ifrom = (tid * idelta > inum) ? inum : tid * idelta;
+    mark_range(ifrom, ifrom + idelta);
+    thr->_fmask_stamp = lmp->neighbor->ncalls;
+  }
+
+  const auto stolen = fix->get_sched()->get_stolen(tid);
+  if (stolen)
+    for (const auto &range : *stolen) mark_range(range.first, range.second);
+
+  thr->_fsparse = fix->get_reduce_atomic() ||
+    ((double) thr->_nmark < FSPARSE_FRACTION * nblock);
+}
+
 /* ----------------------------------------------------------------------
    tally eng_vdwl and eng_coul into per thread global and per-atom accumulators
 ------------------------------------------------------------------------- */
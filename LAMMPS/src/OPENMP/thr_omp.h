@@ -25,6 +25,7 @@
 #include "fix_omp.h"    // IWYU pragma: export
 #include "pointers.h"
 #include "thr_data.h"    // IWYU pragma: export
+#include "thr_sched.h"    // IWYU pragma: export
 
 namespace LAMMPS_NS {
 
@@ -43,12 +44,16 @@ class ThrOMP {
 
   const int thr_style;
   int thr_error;
+  // set by pair styles that only apply forces to the atoms of their
+  // neighbor list and their neighbors. allows block-wise force reduction
+  int thr_fmask_flag;
 
  public:
   ThrOMP(LAMMPS *, int);
   virtual ~ThrOMP() noexcept(false) {}
 
   double memory_usage_thr();
+  int get_fmask_flag() const { return thr_fmask_flag; }
 
   inline void sync_threads()
   {
@@ -84,6 +89,9 @@ class ThrOMP {
   // reduce per thread data as needed
   void reduce_thr(void *const style, const int eflag, const int vflag, ThrData *const thr);
 
+  // mark force blocks this thread may have written to for the block-wise reduction
+  void mark_force_thr(Pair *const, const int, ThrData *const);
+
   // thread safe variant error abort support.
   // signals an error condition in any thread by making
   // thr_error > 0, if condition "cond" is true.
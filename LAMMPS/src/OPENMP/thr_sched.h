@@ -0,0 +1,71 @@
+/* -*- c++ -*- -------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_THR_SCHED_H
+#define LMP_THR_SCHED_H
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+// hands out ranges of the inum loop of a threaded style.
+// each thread owns a contiguous range, same as loop_setup_thr().
+// with stealing, a thread works on its range in chunks and, once it
+// is exhausted, takes the upper half of the remaining range of another
+// thread, so threads with cheap atoms help out those with costly ones.
+
+class ThrSched {
+ public:
+  ThrSched();
+  ~ThrSched();
+
+  // split inum into one range per thread, call outside a parallel region
+  void setup(int inum, int nthreads);
+  // next [ifrom,ito) range for thread tid, false if no work is left
+  bool next(int tid, int &ifrom, int &ito);
+
+  // ranges that thread tid took over from other threads since the last setup()
+  const std::vector<std::pair<int, int>> *get_stolen(int tid) const
+  {
+    return (tid < _nmax) ? _stolen + tid : nullptr;
+  }
+
+  void set_steal(bool flag) { _steal = flag; }
+  bool get_steal() const { return _steal; }
+
+ private:
+  // remaining range of one thread, packed as (from << 32 | to) so that
+  // the owner and thieves can update it with a single compare-and-swap.
+  // padded to a cache line to avoid false sharing between threads.
+  struct Range {
+    std::atomic<uint64_t> bounds;
+    char pad[64 - sizeof(std::atomic<uint64_t>)];
+  };
+
+  Range *_range;    // one remaining range per thread
+  std::vector<std::pair<int, int>> *_stolen;    // stolen ranges per thread
+  int _nmax;        // allocated size of _range
+  int _nthr;        // number of threads in current loop
+  int _chunk;       // number of atoms taken by the owner at a time
+  bool _steal;      // true if idle threads steal work
+
+  bool pop(int tid, int &ifrom, int &ito);
+  bool steal(int tid, int victim);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
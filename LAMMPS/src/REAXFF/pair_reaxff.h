@@ -83,6 +83,7 @@ class PairReaxFF : public Pair {
   int nmax;
   void FindBond();
   double memory_usage() override;
+  void finish() override;
 };
 
 }    // namespace LAMMPS_NS
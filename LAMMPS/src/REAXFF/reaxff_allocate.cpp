@@ -31,6 +31,8 @@
 #include "memory.h"
 #include "pair.h"
 
+#include <cstring>
+
 namespace ReaxFF {
 
   /* allocate space for my_atoms
@@ -84,88 +86,71 @@ namespace ReaxFF {
 
     workspace->allocated = 0;
 
-    /* bond order storage */
-    sfree(workspace->total_bond_order);
-    sfree(workspace->Deltap);
-    sfree(workspace->Deltap_boc);
-    sfree(workspace->dDeltap_self);
-    sfree(workspace->Delta);
-    sfree(workspace->Delta_lp);
-    sfree(workspace->Delta_lp_temp);
-    sfree(workspace->dDelta_lp);
-    sfree(workspace->dDelta_lp_temp);
-    sfree(workspace->Delta_e);
-    sfree(workspace->Delta_boc);
-    sfree(workspace->Delta_val);
-    sfree(workspace->nlp);
-    sfree(workspace->nlp_temp);
-    sfree(workspace->Clp);
-    sfree(workspace->vlpex);
-    sfree(workspace->bond_mark);
-
-    /* force related storage */
-    sfree(workspace->f);
-    sfree(workspace->CdDelta);
-
-    /* reductions */
+    /* all per-atom arrays live in the workspace arena */
+    Arena_Free(&workspace->arena);
 
-    if (workspace->CdDeltaReduction)
-      sfree(workspace->CdDeltaReduction);
-    if (workspace->forceReduction)
-      sfree(workspace->forceReduction);
-    if (workspace->valence_angle_atom_myoffset)
-      sfree(workspace->valence_angle_atom_myoffset);
+    workspace->CdDeltaReduction = nullptr;
+    workspace->forceReduction = nullptr;
+    workspace->valence_angle_atom_myoffset = nullptr;
   }
 
+  /* carve the per-atom arrays for total_cap atoms out of the workspace
+     arena. the arena only grows, so calling this again with the same
+     or a smaller capacity reuses the existing block */
   void Allocate_Workspace(control_params *control, storage *workspace, int total_cap)
   {
-    int total_real, total_rvec;
+    rc_bigint total_real, total_rvec, total_int, total_reduce;
     auto error = control->error_ptr;
+    reax_arena *arena = &workspace->arena;
 
     workspace->allocated = 1;
-    total_real = total_cap * sizeof(double);
-    total_rvec = total_cap * sizeof(rvec);
+    total_real = (rc_bigint)total_cap * sizeof(double);
+    total_rvec = (rc_bigint)total_cap * sizeof(rvec);
+    total_int = (rc_bigint)total_cap * sizeof(int);
+    total_reduce = (rc_bigint)total_cap * control->nthreads;
+
+    Arena_Reset(error, arena, 16 * Arena_Chunk(total_real) + 2 * Arena_Chunk(total_rvec) +
+                2 * Arena_Chunk(total_int) + Arena_Chunk(total_reduce * sizeof(double)) +
+                Arena_Chunk(total_reduce * sizeof(rvec)), "workspace");
 
     /* bond order related storage  */
-    workspace->total_bond_order = (double*) smalloc(error, total_real, "total_bo");
-    workspace->Deltap = (double*) smalloc(error, total_real, "Deltap");
-    workspace->Deltap_boc = (double*) smalloc(error, total_real, "Deltap_boc");
-    workspace->dDeltap_self = (rvec*) smalloc(error, total_rvec, "dDeltap_self");
-    workspace->Delta = (double*) smalloc(error, total_real, "Delta");
-    workspace->Delta_lp = (double*) smalloc(error, total_real, "Delta_lp");
-    workspace->Delta_lp_temp = (double*) smalloc(error, total_real, "Delta_lp_temp");
-    workspace->dDelta_lp = (double*) smalloc(error, total_real, "dDelta_lp");
-    workspace->dDelta_lp_temp = (double*) smalloc(error, total_real, "dDelta_lp_temp");
-    workspace->Delta_e = (double*) smalloc(error, total_real, "Delta_e");
-    workspace->Delta_boc = (double*) smalloc(error, total_real, "Delta_boc");
-    workspace->Delta_val = (double*) smalloc(error, total_real, "Delta_val");
-    workspace->nlp = (double*) smalloc(error, total_real, "nlp");
-    workspace->nlp_temp = (double*) smalloc(error, total_real, "nlp_temp");
-    workspace->Clp = (double*) smalloc(error, total_real, "Clp");
-    workspace->vlpex = (double*) smalloc(error, total_real, "vlpex");
-    workspace->bond_mark = (int*) scalloc(error, total_cap, sizeof(int), "bond_mark");
+    workspace->total_bond_order = (double*) Arena_Take(error, arena, total_real);
+    workspace->Deltap = (double*) Arena_Take(error, arena, total_real);
+    workspace->Deltap_boc = (double*) Arena_Take(error, arena, total_real);
+    workspace->dDeltap_self = (rvec*) Arena_Take(error, arena, total_rvec);
+    workspace->Delta = (double*) Arena_Take(error, arena, total_real);
+    workspace->Delta_lp = (double*) Arena_Take(error, arena, total_real);
+    workspace->Delta_lp_temp = (double*) Arena_Take(error, arena, total_real);
+    workspace->dDelta_lp = (double*) Arena_Take(error, arena, total_real);
+    workspace->dDelta_lp_temp = (double*) Arena_Take(error, arena, total_real);
+    workspace->Delta_e = (double*) Arena_Take(error, arena, total_real);
+    workspace->Delta_boc = (double*) Arena_Take(error, arena, total_real);
+    workspace->Delta_val = (double*) Arena_Take(error, arena, total_real);
+    workspace->nlp = (double*) Arena_Take(error, arena, total_real);
+    workspace->nlp_temp = (double*) Arena_Take(error, arena, total_real);
+    workspace->Clp = (double*) Arena_Take(error, arena, total_real);
+    workspace->vlpex = (double*) Arena_Take(error, arena, total_real);
+    workspace->bond_mark = (int*) Arena_Take(error, arena, total_int);
+    memset(workspace->bond_mark, 0, total_int);
 
     /* force related storage */
-    workspace->f = (rvec*) scalloc(error, total_cap, sizeof(rvec), "f");
-    workspace->CdDelta = (double*) scalloc(error, total_cap, sizeof(double), "CdDelta");
+    workspace->f = (rvec*) Arena_Take(error, arena, total_rvec);
+    memset(workspace->f, 0, total_rvec);
+    workspace->CdDelta = (double*) Arena_Take(error, arena, total_real);
+    memset(workspace->CdDelta, 0, total_real);
 
     // storage for reductions with multiple threads
 
-    workspace->CdDeltaReduction = (double *) scalloc(error,
-      sizeof(double), (rc_bigint)total_cap*control->nthreads, "cddelta_reduce");
-    workspace->forceReduction = (rvec *) scalloc(error,
-      sizeof(rvec), (rc_bigint)total_cap*control->nthreads, "forceReduction");
-    workspace->valence_angle_atom_myoffset = (int *) scalloc(error,
-     sizeof(int), total_cap, "valence_angle_atom_myoffset");
+    workspace->CdDeltaReduction =
+      (double *) Arena_Take(error, arena, total_reduce * sizeof(double));
+    memset(workspace->CdDeltaReduction, 0, total_reduce * sizeof(double));
+    workspace->forceReduction = (rvec *) Arena_Take(error, arena, total_reduce * sizeof(rvec));
+    memset(workspace->forceReduction, 0, total_reduce * sizeof(rvec));
+    workspace->valence_angle_atom_myoffset = (int *) Arena_Take(error, arena, total_int);
+    memset(workspace->valence_angle_atom_myoffset, 0, total_int);
   }
 
 
-  static void Reallocate_Neighbor_List(reax_list *far_nbrs, int n, int num_intrs)
-  {
-    Delete_List(far_nbrs);
-    Make_List(n, num_intrs, TYP_FAR_NEIGHBOR, far_nbrs);
-  }
-
   static int Reallocate_HBonds_List(reax_system *system, reax_list *hbonds)
   {
     int i, total_hbonds;
@@ -180,7 +165,6 @@ namespace ReaxFF {
       }
     total_hbonds = (int)(MAX(total_hbonds*saferzone, mincap*system->minhbonds));
 
-    Delete_List(hbonds);
     Make_List(system->Hcap, total_hbonds, TYP_HBOND, hbonds);
 
     return total_hbonds;
@@ -206,7 +190,6 @@ namespace ReaxFF {
       for (i = 0; i < bonds->num_intrs; ++i)
         sfree(bonds->select.bond_list[i].bo_data.CdboReduction);
 
-    Delete_List(bonds);
     Make_List(system->total_cap, *total_bonds, TYP_BOND, bonds);
 
     if (system->omp_active)
@@ -242,8 +225,7 @@ namespace ReaxFF {
       /* system */
       system->my_atoms = (reax_atom *)::realloc(system->my_atoms,
         system->total_cap*sizeof(reax_atom));
-      /* workspace */
-      DeAllocate_Workspace(workspace);
+      /* workspace, reuses its arena unless it has to grow */
       Allocate_Workspace(control, workspace, system->total_cap);
     }
 
@@ -259,7 +241,7 @@ namespace ReaxFF {
       newsize = static_cast<int>
         (MAX(wsr->num_far*safezone, mincap*REAX_MIN_NBRS));
 
-      Reallocate_Neighbor_List(far_nbrs, system->total_cap, newsize);
+      Make_List(system->total_cap, newsize, TYP_FAR_NEIGHBOR, far_nbrs);
       wsr->num_far = 0;
     }
 
@@ -300,8 +282,6 @@ namespace ReaxFF {
 
     /* 3-body list */
     if (wsr->num_3body > 0) {
-      Delete_List((*lists)+THREE_BODIES);
-
       if (num_bonds == -1)
         num_bonds = ((*lists)+BONDS)->num_intrs;
 
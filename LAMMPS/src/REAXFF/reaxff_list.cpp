@@ -32,48 +32,60 @@
 namespace ReaxFF {
 
   /************* allocate list space ******************/
+  /* (re)shape a list for n atoms and num_intrs interactions. the
+     storage is taken from the arena of the list, which keeps its
+     largest size, so rebuilding a list after a reneighbor or a
+     capacity change only allocates when the list outgrows it */
   void Make_List(int n, int num_intrs, int type, reax_list *l)
   {
+    rc_bigint intr_size;
+
+    switch(type) {
+    case TYP_THREE_BODY:
+      intr_size = sizeof(three_body_interaction_data);
+      break;
+    case TYP_BOND:
+      intr_size = sizeof(bond_data);
+      break;
+    case TYP_FAR_NEIGHBOR:
+      intr_size = sizeof(far_neighbor_data);
+      break;
+    case TYP_HBOND:
+      intr_size = sizeof(hbond_data);
+      break;
+    default:
+      l->error_ptr->all(FLERR,fmt::format("No list type {} defined", type));
+      return;
+    }
+
     l->allocated = 1;
 
     l->n = n;
     l->num_intrs = num_intrs;
+    l->type = type;
 
-    if (l->index) sfree(l->index);
-    if (l->end_index) sfree(l->end_index);
-    l->index = (int*) smalloc(l->error_ptr, n * sizeof(int), "list:index");
-    l->end_index = (int*) smalloc(l->error_ptr, n * sizeof(int), "list:end_index");
+    const rc_bigint index_size = (rc_bigint) n * sizeof(int);
+    const rc_bigint list_size = (rc_bigint) num_intrs * intr_size;
+    Arena_Reset(l->error_ptr, &l->mem, 2 * Arena_Chunk(index_size) + Arena_Chunk(list_size),
+                "list");
 
-    l->type = type;
+    l->index = (int*) Arena_Take(l->error_ptr, &l->mem, index_size);
+    l->end_index = (int*) Arena_Take(l->error_ptr, &l->mem, index_size);
+    void *intrs = Arena_Take(l->error_ptr, &l->mem, list_size);
 
     switch(l->type) {
     case TYP_THREE_BODY:
-      if (l->select.three_body_list) sfree(l->select.three_body_list);
-      l->select.three_body_list = (three_body_interaction_data*)
-        smalloc(l->error_ptr, (rc_bigint) num_intrs * sizeof(three_body_interaction_data),
-                "list:three_bodies");
+      l->select.three_body_list = (three_body_interaction_data*) intrs;
       break;
-
     case TYP_BOND:
-      if (l->select.bond_list) sfree(l->select.bond_list);
-      l->select.bond_list = (bond_data*)
-        smalloc(l->error_ptr, (rc_bigint) num_intrs * sizeof(bond_data), "list:bonds");
+      l->select.bond_list = (bond_data*) intrs;
       break;
-
     case TYP_FAR_NEIGHBOR:
-      if (l->select.far_nbr_list) sfree(l->select.far_nbr_list);
-      l->select.far_nbr_list = (far_neighbor_data*)
-        smalloc(l->error_ptr, (rc_bigint) num_intrs * sizeof(far_neighbor_data), "list:far_nbrs");
+      l->select.far_nbr_list = (far_neighbor_data*) intrs;
       break;
-
     case TYP_HBOND:
-      if (l->select.hbond_list) sfree(l->select.hbond_list);
-      l->select.hbond_list = (hbond_data*)
-        smalloc(l->error_ptr, (rc_bigint) num_intrs * sizeof(hbond_data), "list:hbonds");
+      l->select.hbond_list = (hbond_data*) intrs;
       break;
-
-    default:
-      l->error_ptr->all(FLERR,fmt::format("No list type {} defined", l->type));
     }
   }
 
@@ -83,31 +95,10 @@ namespace ReaxFF {
       return;
     l->allocated = 0;
 
-    sfree(l->index);
-    sfree(l->end_index);
+    Arena_Free(&l->mem);
     l->index = nullptr;
     l->end_index = nullptr;
-
-    switch(l->type) {
-    case TYP_HBOND:
-      sfree(l->select.hbond_list);
-      l->select.hbond_list = nullptr;
-      break;
-    case TYP_FAR_NEIGHBOR:
-      sfree(l->select.far_nbr_list);
-      l->select.far_nbr_list = nullptr;
-      break;
-    case TYP_BOND:
-      sfree(l->select.bond_list);
-      l->select.bond_list = nullptr;
-      break;
-    case TYP_THREE_BODY:
-      sfree(l->select.three_body_list);
-      l->select.three_body_list = nullptr;
-      break;
-
-    default:
-      l->error_ptr->all(FLERR,fmt::format("No list type {} defined", l->type));
-    }
+    l->select.bond_list = nullptr;
+    l->top = l->max_top = 0;
   }
 }
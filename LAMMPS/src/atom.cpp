@@ -105,6 +105,7 @@ Atom::Atom(LAMMPS *_lmp) : Pointers(_lmp), atom_style(nullptr), avec(nullptr), a
   userbinsize = 0.0;
   maxbin = maxnext = 0;
   binhead = nullptr;
+  binrank = nullptr;
   next = permute = nullptr;
 
   // --------------------------------------------------------------------
@@ -294,6 +295,7 @@ Atom::~Atom()
 
   delete[] firstgroupname;
   memory->destroy(binhead);
+  memory->destroy(binrank);
   memory->destroy(next);
   memory->destroy(permute);
 
@@ -2350,6 +2352,7 @@ void Atom::sort()
     iy = MIN(iy,nbiny-1);
     iz = MIN(iz,nbinz-1);
     ibin = iz*nbiny*nbinx + iy*nbinx + ix;
+    if (binrank) ibin = binrank[ibin];
     next[i] = binhead[ibin];
     binhead[ibin] = i;
   }
@@ -2548,7 +2551,17 @@ void Atom::setup_sort_bins()
     memory->destroy(binhead);
     maxbin = nbins;
     memory->create(binhead,maxbin,"atom:binhead");
+    memory->destroy(binrank);
   }
+
+  // with neighbor binsort, visit bins along a Morton curve so the atom order
+  // follows the packed order of the neighbor bins, which use the same bin size
+  // by default
+
+  if (neighbor->binsortflag) {
+    if (!binrank) memory->create(binrank,maxbin,"atom:binrank");
+    utils::morton_rank(nbinx,nbiny,nbinz,binrank);
+  } else memory->destroy(binrank);
 }
 
 /* ----------------------------------------------------------------------
@@ -3252,6 +3265,7 @@ double Atom::memory_usage()
     bytes += memory->usage(next,maxnext);
     bytes += memory->usage(permute,maxnext);
   }
+  if (binrank) bytes += memory->usage(binrank,maxbin);
 
   return bytes;
 }
@@ -430,6 +430,7 @@ class Atom : protected Pointers {
   int maxbin;                          // max # of bins
   int maxnext;                         // max size of next,permute
   int *binhead;                        // 1st atom in each bin
+  int *binrank;                        // Morton rank of each bin, if neighbor binsort
   int *next;                           // next atom in bin
   int *permute;                        // permutation vector
   double bininvx, bininvy, bininvz;    // inverse actual bin sizes
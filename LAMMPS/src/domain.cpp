@@ -1663,6 +1663,65 @@ void Domain::remap(double *x)
   if (triclinic) lamda2x(coord,x);
 }
 
+/* ----------------------------------------------------------------------
+   remap N points packed as (x,y,z) triplets into the periodic box
+   no image flag calculation
+   same result as remap() on each point, but branch-free so it vectorizes
+   non-periodic dims get a zero period and unbounded lo/hi so they are unchanged
+   for triclinic, points are converted to lamda coords (0-1) and back
+------------------------------------------------------------------------- */
+
+void Domain::remap_all(int n, double *x)
+{
+  double lo[3],hi[3],period[3],inv[3];
+
+  for (int dim = 0; dim < 3; dim++) {
+    if (periodicity[dim]) {
+      lo[dim] = triclinic ? boxlo_lamda[dim] : boxlo[dim];
+      hi[dim] = triclinic ? boxhi_lamda[dim] : boxhi[dim];
+      period[dim] = triclinic ? prd_lamda[dim] : prd[dim];
+      inv[dim] = 1.0/period[dim];
+    } else {
+      lo[dim] = -BIG;
+      hi[dim] = BIG;
+      period[dim] = inv[dim] = 0.0;
+    }
+  }
+
+  if (triclinic == 0) {
+    for (int i = 0; i < 3*n; i += 3) {
+      for (int dim = 0; dim < 3; dim++) {
+        double coord = x[i+dim];
+        coord -= floor((coord-lo[dim])*inv[dim]) * period[dim];
+        coord -= (coord >= hi[dim]) ? period[dim] : 0.0;
+        x[i+dim] = MAX(coord,lo[dim]);
+      }
+    }
+  } else {
+    for (int i = 0; i < 3*n; i += 3) {
+      double delta[3],lamda[3];
+      delta[0] = x[i] - boxlo[0];
+      delta[1] = x[i+1] - boxlo[1];
+      delta[2] = x[i+2] - boxlo[2];
+
+      lamda[0] = h_inv[0]*delta[0] + h_inv[5]*delta[1] + h_inv[4]*delta[2];
+      lamda[1] = h_inv[1]*delta[1] + h_inv[3]*delta[2];
+      lamda[2] = h_inv[2]*delta[2];
+
+      for (int dim = 0; dim < 3; dim++) {
+        double coord = lamda[dim];
+        coord -= floor((coord-lo[dim])*inv[dim]) * period[dim];
+        coord -= (coord >= hi[dim]) ? period[dim] : 0.0;
+        lamda[dim] = MAX(coord,lo[dim]);
+      }
+
+      x[i] = h[0]*lamda[0] + h[5]*lamda[1] + h[4]*lamda[2] + boxlo[0];
+      x[i+1] = h[1]*lamda[1] + h[3]*lamda[2] + boxlo[1];
+      x[i+2] = h[2]*lamda[2] + boxlo[2];
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    remap xnew to be within half box length of xold
    do it directly, not iteratively, in case is far away
@@ -136,6 +136,7 @@ class Domain : protected Pointers {
   void closest_image(const double *const, const double *const, double *const);
   void remap(double *, imageint &);
   void remap(double *);
+  void remap_all(int, double *);
   void remap_near(double *, double *);
   void unmap_inv(double *x, imageint);
   void unmap(double *, imageint);
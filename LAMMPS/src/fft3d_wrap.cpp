@@ -25,13 +25,16 @@ FFT3d::FFT3d(LAMMPS *lmp, MPI_Comm comm, int nfast, int nmid, int nslow,
              int in_klo, int in_khi,
              int out_ilo, int out_ihi, int out_jlo, int out_jhi,
              int out_klo, int out_khi,
-             int scaled, int permute, int *nbuf, int usecollective) : Pointers(lmp)
+             int scaled, int permute, int *nbuf, int usecollective,
+             const char *backend) : Pointers(lmp)
 {
   #ifndef FFT_HEFFTE
+  if (backend && !fft_3d_find_backend(backend))
+    error->all(FLERR,"Unknown FFT backend {}",backend);
   plan = fft_3d_create_plan(comm,nfast,nmid,nslow,
                             in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
                             out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
-                            scaled,permute,nbuf,usecollective);
+                            scaled,permute,nbuf,usecollective,backend);
   if (plan == nullptr) error->one(FLERR,"Could not create 3d FFT plan");
   #else
   heffte::plan_options options = heffte::default_options<heffte_backend>();
@@ -90,3 +93,16 @@ void FFT3d::timing1d(FFT_SCALAR *in, int nsize, int flag)
   fft_1d_only((FFT_DATA *) in,nsize,flag,plan);
   #endif
 }
+
+/* ---------------------------------------------------------------------- */
+
+const char *FFT3d::backend_name(const char *backend)
+{
+  #ifndef FFT_HEFFTE
+  const struct fft_backend *selected =
+    fft_3d_find_backend(backend ? backend : fft_3d_default_backend());
+  return selected ? selected->name : "unknown";
+  #else
+  return LMP_FFT_LIB;
+  #endif
+}
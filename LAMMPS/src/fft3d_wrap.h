@@ -37,11 +37,14 @@ class FFT3d : protected Pointers {
   enum { FORWARD = 1, BACKWARD = -1 };
 
   FFT3d(class LAMMPS *, MPI_Comm, int, int, int, int, int, int, int, int, int, int, int, int, int,
-        int, int, int, int, int *, int);
+        int, int, int, int, int *, int, const char *backend = nullptr);
   ~FFT3d() override;
   void compute(FFT_SCALAR *, FFT_SCALAR *, int);
   void timing1d(FFT_SCALAR *, int, int);
 
+  // name of the 1d FFT implementation used for a requested backend
+  static const char *backend_name(const char *);
+
  private:
   #ifdef FFT_HEFFTE
   // the heFFTe plan supersedes the internal fft_plan_3d
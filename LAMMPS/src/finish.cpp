@@ -384,6 +384,14 @@ void Finish::end(int flag)
         omp_times(fixomp,"Kspace",Timer::KSPACE,nthreads,screen,logfile);
       omp_times(fixomp,"Neigh",Timer::NEIGH,nthreads,screen,logfile);
       omp_times(fixomp,"Reduce",Timer::COMM,nthreads,screen,logfile);
+
+      // wait time of threads that finished their share of a threaded loop early
+
+      double thr_idle = 0.0;
+      for (i=0; i < nthreads; ++i)
+        thr_idle += fixomp->get_thr(i)->get_time(Timer::IDLE);
+      if (thr_idle > 0.0)
+        omp_times(fixomp,"Idle",Timer::IDLE,nthreads,screen,logfile);
     }
   }
 #endif
@@ -452,6 +460,19 @@ void Finish::end(int flag)
                      time3d,fraction,flop3,flop1);
   }
 
+  // solves and force drift of kspace_modify every
+
+  if (timeflag && !minflag && force->kspace && force->kspace->every > 1 &&
+      force->kspace->nstep_every && me == 0) {
+    KSpace *kspace = force->kspace;
+    double drift_ave = kspace->ndrift ? kspace->drift_sum/kspace->ndrift : 0.0;
+    utils::logmesg(lmp,"\nKspace solves = {} of {} steps, every {}, extrapolate {}\n"
+                   "Kspace force drift ave = {:.6g} max = {:.6g} last = {:.6g}\n",
+                   kspace->nsolve_every,kspace->nstep_every,kspace->every,
+                   kspace->extrapolate_flag ? "linear" : "none",
+                   drift_ave,kspace->drift_max,kspace->drift_last);
+  }
+
   nneigh = nneighfull = 0;
   if (histoflag) {
     std::string mesg = "\n";
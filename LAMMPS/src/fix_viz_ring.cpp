@@ -0,0 +1,312 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_viz_ring.h"
+
+#include "arg_info.h"
+#include "atom.h"
+#include "comm.h"
+#include "compute.h"
+#include "domain.h"
+#include "error.h"
+#include "group.h"
+#include "modify.h"
+#include "update.h"
+
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+enum { X = 100, V, TYPE };
+
+static constexpr char VIZ_MAGIC[8] = "LMPVIZ1";
+static constexpr size_t VIZ_ALIGN = 64;    // keep header and slots on separate cache lines
+
+static size_t align_up(size_t n)
+{
+  return (n + VIZ_ALIGN - 1) / VIZ_ALIGN * VIZ_ALIGN;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixVizRing::FixVizRing(LAMMPS *lmp, int narg, char **arg) :
+    Fix(lmp, narg, arg), shmbase(nullptr), ring(nullptr)
+{
+  if (narg < 7) utils::missing_cmd_args(FLERR, "fix viz/ring", error);
+
+#if defined(_WIN32)
+  error->all(FLERR, "Fix viz/ring is not supported on Windows");
+#endif
+
+  if (comm->nprocs > 1) error->all(FLERR, "Fix viz/ring requires a single MPI process");
+
+  nevery = utils::inumeric(FLERR, arg[3], false, lmp);
+  if (nevery <= 0) error->all(FLERR, "Invalid fix viz/ring every argument: {}", nevery);
+
+  shmname = arg[4];
+  if (shmname[0] != '/') shmname = "/" + shmname;
+
+  nslots = utils::inumeric(FLERR, arg[5], false, lmp);
+  if (nslots < 2) error->all(FLERR, "Invalid fix viz/ring number of slots: {}", nslots);
+
+  // parse values, column 0 is always the atom ID
+
+  ncols = 1;
+  for (int iarg = 6; iarg < narg; iarg++) {
+    value_t val;
+    val.argindex = 0;
+    val.c = nullptr;
+
+    if (strcmp(arg[iarg], "x") == 0) {
+      val.which = X;
+      ncols += 3;
+    } else if (strcmp(arg[iarg], "v") == 0) {
+      val.which = V;
+      ncols += 3;
+    } else if (strcmp(arg[iarg], "type") == 0) {
+      val.which = TYPE;
+      ncols += 1;
+    } else {
+      ArgInfo argi(arg[iarg], ArgInfo::COMPUTE);
+      if ((argi.get_type() != ArgInfo::COMPUTE) || (argi.get_dim() > 1))
+        error->all(FLERR, "Invalid fix viz/ring argument: {}", arg[iarg]);
+
+      val.which = ArgInfo::COMPUTE;
+      val.argindex = argi.get_index1();
+      val.id = argi.get_name();
+
+      auto icompute = modify->get_compute_by_id(val.id);
+      if (!icompute) error->all(FLERR, "Compute ID {} for fix viz/ring does not exist", val.id);
+      if (icompute->peratom_flag == 0)
+        error->all(FLERR, "Fix viz/ring compute {} does not calculate per-atom values", val.id);
+      if ((val.argindex == 0) && (icompute->size_peratom_cols != 0))
+        error->all(FLERR, "Fix viz/ring compute {} does not calculate a per-atom vector", val.id);
+      if (val.argindex && (icompute->size_peratom_cols == 0))
+        error->all(FLERR, "Fix viz/ring compute {} does not calculate a per-atom array", val.id);
+      if (val.argindex && (val.argindex > icompute->size_peratom_cols))
+        error->all(FLERR, "Fix viz/ring compute {} array is accessed out-of-range", val.id);
+      ncols += 1;
+    }
+    values.push_back(val);
+  }
+
+  // size the ring for the atoms currently in the group
+
+  maxatoms = group->count(igroup);
+  size_t slot_bytes = align_up(sizeof(VizRingSlot) + sizeof(double) * ncols * maxatoms);
+  shmsize = align_up(sizeof(VizRingHeader)) + slot_bytes * nslots;
+
+#if !defined(_WIN32)
+  int fd = shm_open(shmname.c_str(), O_CREAT | O_RDWR, 0644);
+  if (fd < 0) error->one(FLERR, "Cannot create shared memory {}: {}", shmname, utils::getsyserror());
+  if (ftruncate(fd, shmsize) != 0) {
+    close(fd);
+    error->one(FLERR, "Cannot resize shared memory {}: {}", shmname, utils::getsyserror());
+  }
+  void *ptr = mmap(nullptr, shmsize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED)
+    error->one(FLERR, "Cannot map shared memory {}: {}", shmname, utils::getsyserror());
+  shmbase = (char *) ptr;
+#endif
+
+  ring = (VizRingHeader *) shmbase;
+  memcpy(ring->magic, VIZ_MAGIC, sizeof(VIZ_MAGIC));
+  ring->nslots = nslots;
+  ring->ncols = ncols;
+  ring->maxatoms = maxatoms;
+  ring->slot_bytes = slot_bytes;
+  for (int i = 0; i < nslots; i++) get_slot(ring, i)->seq.store(0, std::memory_order_relaxed);
+  ring->latest.store(-1, std::memory_order_release);
+
+  nframe = 0;
+  overflow_warned = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixVizRing::~FixVizRing()
+{
+#if !defined(_WIN32)
+  if (shmbase) {
+    munmap(shmbase, shmsize);
+    shm_unlink(shmname.c_str());
+  }
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixVizRing::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixVizRing::init()
+{
+  for (auto &val : values) {
+    if (val.which == ArgInfo::COMPUTE) {
+      val.c = modify->get_compute_by_id(val.id);
+      if (!val.c) error->all(FLERR, "Compute ID {} for fix viz/ring does not exist", val.id);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   publish the initial frame of a run
+------------------------------------------------------------------------- */
+
+void FixVizRing::setup(int /*vflag*/)
+{
+  if (update->ntimestep % nevery == 0) end_of_step();
+}
+
+/* ----------------------------------------------------------------------
+   write one frame into the next slot of the ring
+   the slot sequence number acts as a seqlock, so readers never block
+   the writer and can detect frames that were overwritten while reading
+------------------------------------------------------------------------- */
+
+void FixVizRing::end_of_step()
+{
+  int64_t frame = nframe++;
+  VizRingSlot *s = get_slot(ring, frame);
+
+  s->seq.store(2 * frame + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  modify->clearstep_compute();
+
+  s->timestep = update->ntimestep;
+  for (int dim = 0; dim < 3; dim++) s->boxlo[dim] = domain->boxlo[dim];
+  for (int k = 0; k < 6; k++) s->h[k] = domain->h[k];
+
+  double **x = atom->x;
+  double **v = atom->v;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  tagint *tag = atom->tag;
+  int nlocal = atom->nlocal;
+
+  for (auto &val : values) {
+    if ((val.which == ArgInfo::COMPUTE) && !(val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
+      val.c->compute_peratom();
+      val.c->invoked_flag |= Compute::INVOKED_PERATOM;
+    }
+  }
+
+  auto data = (double *) (s + 1);
+  bigint n = 0;
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    if (n == maxatoms) {
+      if (!overflow_warned)
+        error->warning(FLERR, "Fix viz/ring group has grown beyond {} atoms, frames are truncated",
+                       maxatoms);
+      overflow_warned = 1;
+      break;
+    }
+
+    double *row = data + n * ncols;
+    int m = 0;
+    row[m++] = tag[i];
+    for (auto &val : values) {
+      if (val.which == X) {
+        row[m++] = x[i][0];
+        row[m++] = x[i][1];
+        row[m++] = x[i][2];
+      } else if (val.which == V) {
+        row[m++] = v[i][0];
+        row[m++] = v[i][1];
+        row[m++] = v[i][2];
+      } else if (val.which == TYPE) {
+        row[m++] = type[i];
+      } else if (val.argindex == 0) {
+        row[m++] = val.c->vector_atom[i];
+      } else {
+        row[m++] = val.c->array_atom[i][val.argindex - 1];
+      }
+    }
+    n++;
+  }
+  s->natoms = n;
+
+  s->seq.store(2 * frame + 2, std::memory_order_release);
+  ring->latest.store(frame, std::memory_order_release);
+
+  modify->addstep_compute(update->ntimestep + nevery);
+}
+
+/* ----------------------------------------------------------------------
+   return slot that holds the given frame number
+------------------------------------------------------------------------- */
+
+VizRingSlot *FixVizRing::get_slot(VizRingHeader *header, int64_t frame)
+{
+  char *base = (char *) header + align_up(sizeof(VizRingHeader));
+  return (VizRingSlot *) (base + (frame % header->nslots) * header->slot_bytes);
+}
+
+/* ----------------------------------------------------------------------
+   map the ring written by a fix viz/ring, possibly in another process
+   return nullptr if it does not exist or is not a viz/ring segment
+------------------------------------------------------------------------- */
+
+VizRingHeader *FixVizRing::open_reader(const char *name)
+{
+#if defined(_WIN32)
+  return nullptr;
+#else
+  std::string shmname = name;
+  if (shmname[0] != '/') shmname = "/" + shmname;
+
+  int fd = shm_open(shmname.c_str(), O_RDONLY, 0);
+  if (fd < 0) return nullptr;
+
+  struct stat info;
+  void *ptr = MAP_FAILED;
+  if ((fstat(fd, &info) == 0) && (info.st_size >= (off_t) sizeof(VizRingHeader)))
+    ptr = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) return nullptr;
+
+  auto header = (VizRingHeader *) ptr;
+  if (memcmp(header->magic, VIZ_MAGIC, sizeof(VIZ_MAGIC)) != 0) {
+    munmap(ptr, info.st_size);
+    return nullptr;
+  }
+  return header;
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixVizRing::close_reader(VizRingHeader *header)
+{
+#if !defined(_WIN32)
+  if (header)
+    munmap(header, align_up(sizeof(VizRingHeader)) + header->nslots * header->slot_bytes);
+#endif
+}
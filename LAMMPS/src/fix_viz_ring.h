@@ -0,0 +1,87 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+// clang-format off
+FixStyle(viz/ring,FixVizRing);
+// clang-format on
+#else
+
+#ifndef LMP_FIX_VIZ_RING_H
+#define LMP_FIX_VIZ_RING_H
+
+#include "fix.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace LAMMPS_NS {
+
+// layout of the shared memory segment written by fix viz/ring:
+// one VizRingHeader followed by nslots slots of slot_bytes each.
+// every slot is a VizRingSlot followed by natoms x ncols doubles,
+// column 0 is the atom ID.
+
+struct VizRingHeader {
+  char magic[8];                  // "LMPVIZ1"
+  int32_t nslots;                 // number of frame slots in the ring
+  int32_t ncols;                  // doubles per atom, including the atom ID
+  int64_t maxatoms;               // atoms per slot
+  int64_t slot_bytes;             // size of one slot in bytes
+  std::atomic<int64_t> latest;    // number of the last completed frame, -1 if none
+};
+
+struct VizRingSlot {
+  std::atomic<int64_t> seq;    // 2*frame+1 while frame is written, 2*frame+2 when complete
+  int64_t timestep;
+  int64_t natoms;
+  double boxlo[3];
+  double h[6];
+};
+
+class FixVizRing : public Fix {
+ public:
+  FixVizRing(class LAMMPS *, int, char **);
+  ~FixVizRing() override;
+  int setmask() override;
+  void init() override;
+  void setup(int) override;
+  void end_of_step() override;
+
+  static VizRingHeader *open_reader(const char *);
+  static void close_reader(VizRingHeader *);
+  static VizRingSlot *get_slot(VizRingHeader *, int64_t);
+
+ private:
+  struct value_t {
+    int which;    // X, V, TYPE, or ArgInfo::COMPUTE
+    int argindex;
+    std::string id;
+    class Compute *c;
+  };
+  std::vector<value_t> values;
+
+  std::string shmname;
+  int nslots, ncols;
+  bigint maxatoms;
+  size_t shmsize;
+  char *shmbase;
+  VizRingHeader *ring;
+  int64_t nframe;
+  int overflow_warned;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -19,18 +19,46 @@
 #include "comm.h"
 #include "domain.h"
 #include "error.h"
+#include "fix_store_atom.h"
 #include "force.h"
 #include "memory.h"
+#include "modify.h"
 #include "pair.h"
 #include "suffix.h"
+#include "update.h"
 
 #include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 using namespace LAMMPS_NS;
 
 static constexpr double SMALL = 0.00001;
 
+namespace LAMMPS_NS {
+
+// state of the helper thread that runs KSpace::compute()
+// while the main thread computes pair and bond forces
+
+class KSpaceAsync {
+ public:
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable cv;
+  int eflag, vflag;
+  int nall;                    // number of atoms in private force buffer
+  bool pending;                // true while a compute() is queued or running
+  bool quit;                   // true if the helper thread should exit
+  std::exception_ptr error;    // exception thrown by compute(), if any
+
+  KSpaceAsync() : eflag(0), vflag(0), nall(0), pending(false), quit(false) {}
+};
+
+}    // namespace LAMMPS_NS
+
 /* ---------------------------------------------------------------------- */
 
 KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
@@ -40,6 +68,7 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   virial[0] = virial[1] = virial[2] = virial[3] = virial[4] = virial[5] = 0.0;
 
   triclinic_support = 1;
+  async_support = 0;
   ewaldflag = pppmflag = msmflag = dispersionflag = tip4pflag =
     dipoleflag = spinflag = 0;
   compute_flag = 1;
@@ -52,6 +81,24 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   minorder = 2;
   overlap_allowed = 1;
   fftbench = 0;
+  fft_backend = nullptr;
+  async_flag = 0;
+  private_flag = 0;
+  async = nullptr;
+  f_private = nullptr;
+  nmax_private = 0;
+
+  every = 1;
+  extrapolate_flag = 1;
+  id_fix_every = nullptr;
+  fix_every = nullptr;
+  every_last = every_prev = -1;
+  every_natoms = 0;
+  every_nhistory = 0;
+  every_eflag = every_vflag = 0;
+  nsolve_every = nstep_every = 0;
+  drift_last = drift_max = drift_sum = 0.0;
+  ndrift = 0;
 
   // default to using MPI collectives for FFT/remap only on IBM BlueGene
 
@@ -154,10 +201,28 @@ KSpace::~KSpace()
 {
   if (copymode) return;
 
+  if (async) {
+    {
+      std::unique_lock<std::mutex> lock(async->mutex);
+      async->cv.wait(lock, [this] { return !async->pending; });
+      async->quit = true;
+    }
+    async->cv.notify_all();
+    async->thread.join();
+    delete async;
+  }
+  memory->destroy(f_private);
+
+  // check nfix in case all fixes have already been deleted
+
+  if (id_fix_every && modify->nfix) modify->delete_fix(id_fix_every);
+  delete[] id_fix_every;
+
   memory->destroy(eatom);
   memory->destroy(vatom);
   memory->destroy(gcons);
   memory->destroy(dgcons);
+  delete[] fft_backend;
 }
 
 /* ----------------------------------------------------------------------
@@ -186,6 +251,276 @@ void KSpace::compute_dummy(int eflag, int vflag)
   ev_init(eflag,vflag);
 }
 
+/* ----------------------------------------------------------------------
+   check if compute() can run concurrently with pair and bond styles
+   called by integrator, return 1 if compute_async() may be used
+------------------------------------------------------------------------- */
+
+int KSpace::async_check()
+{
+  if (!async_flag) return 0;
+
+  // the private force buffer covers only forces of this kspace style,
+  // concurrent MPI calls from two threads are not supported and
+  // triclinic styles convert coordinates in place
+
+  const char *reason = nullptr;
+  if (!async_support) reason = "is not supported by this kspace style";
+  else if (every > 1) reason = "is not supported with kspace_modify every";
+  else if (comm->nprocs > 1) reason = "requires a single MPI process";
+  else if (domain->triclinic) reason = "is not supported for triclinic boxes";
+
+  if (reason) {
+    if (comm->me == 0)
+      error->warning(FLERR,"Kspace_modify async {}, computing kspace synchronously",reason);
+    return 0;
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   start compute() on a helper thread, accumulating into a private force
+   buffer, so that it overlaps with pair and bond computations
+   must be followed by compute_wait() before forces are used
+------------------------------------------------------------------------- */
+
+void KSpace::compute_async(int eflag, int vflag)
+{
+  grow_private();
+
+  if (!async) {
+    async = new KSpaceAsync;
+    async->thread = std::thread([this] { async_loop(); });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(async->mutex);
+    async->cv.wait(lock, [this] { return !async->pending; });
+    async->eflag = eflag;
+    async->vflag = vflag;
+    async->nall = atom->nlocal + atom->nghost;
+    async->pending = true;
+    private_flag = 1;
+  }
+  async->cv.notify_all();
+}
+
+/* ----------------------------------------------------------------------
+   wait for compute() started by compute_async() to finish
+   and add its forces to those of the pair and bond styles
+------------------------------------------------------------------------- */
+
+void KSpace::compute_wait()
+{
+  if (!async) return;
+
+  {
+    std::unique_lock<std::mutex> lock(async->mutex);
+    async->cv.wait(lock, [this] { return !async->pending; });
+  }
+  private_flag = 0;
+
+  if (async->error) {
+    std::exception_ptr err = async->error;
+    async->error = nullptr;
+    std::rethrow_exception(err);
+  }
+
+  double **f = atom->f;
+  const int nall = async->nall;
+  for (int i = 0; i < nall; i++) {
+    f[i][0] += f_private[i][0];
+    f[i][1] += f_private[i][1];
+    f[i][2] += f_private[i][2];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   main loop of the helper thread, runs queued compute() calls
+------------------------------------------------------------------------- */
+
+void KSpace::async_loop()
+{
+  std::unique_lock<std::mutex> lock(async->mutex);
+  while (true) {
+    async->cv.wait(lock, [this] { return async->pending || async->quit; });
+    if (async->quit) return;
+    lock.unlock();
+
+    try {
+      if (async->nall) memset(&f_private[0][0],0,sizeof(double)*3*async->nall);
+      compute(async->eflag,async->vflag);
+    } catch (...) {
+      async->error = std::current_exception();
+    }
+
+    lock.lock();
+    async->pending = false;
+    async->cv.notify_all();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   check if compute() can be skipped between solves every N steps
+   called by integrator, return 1 if compute_every() is to be used
+------------------------------------------------------------------------- */
+
+int KSpace::every_check()
+{
+  private_flag = 0;
+  if (every <= 1) return 0;
+
+  // stored forces are per owned atom, so styles that add kspace forces
+  // to ghost atoms (TIP4P) cannot be reused between solves
+
+  if (!async_support || tip4pflag) {
+    if (comm->me == 0)
+      error->warning(FLERR,"Kspace_modify every is not supported by this kspace style, "
+                     "computing kspace every step");
+    return 0;
+  }
+
+  // per-atom storage for the kspace forces of the last two solves
+  // migrates with the atoms, create it the first time
+
+  if (!id_fix_every) {
+    id_fix_every = utils::strdup("KSPACE_EVERY_STORE");
+    modify->add_fix(fmt::format("{} all STORE/ATOM 6 0 0 0",id_fix_every));
+  }
+  fix_every = dynamic_cast<FixStoreAtom *>(modify->get_fix_by_id(id_fix_every));
+  if (!fix_every) error->all(FLERR,"Could not find kspace_modify every fix ID {}",id_fix_every);
+
+  // always start with a solve, positions may have changed since the last run
+
+  every_nhistory = 0;
+  nsolve_every = nstep_every = 0;
+  drift_last = drift_max = drift_sum = 0.0;
+  ndrift = 0;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   replacement for compute() that solves only every N steps
+   in between, the kspace forces of the last solve are reused or
+   linearly extrapolated from the last two solves, and global energy
+   and virial are those of the last solve
+   a solve also happens if per-atom energy/virial are requested,
+   if global energy/virial are requested but the last solve did not
+   compute them, and if the number of atoms changed
+   at each solve the reused forces are compared to the new ones,
+   drift = |F_reused - F_new| / |F_new| summed over all atoms
+------------------------------------------------------------------------- */
+
+void KSpace::compute_every(int eflag, int vflag)
+{
+  const bigint ntimestep = update->ntimestep;
+  const int nlocal = atom->nlocal;
+  double **f = atom->f;
+  double **fstore = fix_every->astore;
+
+  nstep_every++;
+
+  if (atom->natoms != every_natoms) every_nhistory = 0;
+
+  // the timestep went back, e.g. reset_timestep followed by run pre no
+  // which skips every_check(), so the stored solves are from another trajectory
+
+  if (every_nhistory > 0 && ntimestep < every_last) {
+    every_nhistory = 0;
+    every_last = every_prev = -1;
+  }
+
+  int solve = 0;
+  if (every_nhistory == 0 || ntimestep - every_last >= every) solve = 1;
+  else if ((eflag & ENERGY_ATOM) || (vflag & (VIRIAL_ATOM | VIRIAL_CENTROID))) solve = 1;
+  else if ((eflag & ENERGY_GLOBAL) && !(every_eflag & ENERGY_GLOBAL)) solve = 1;
+  else if ((vflag & (VIRIAL_PAIR | VIRIAL_FDOTR)) &&
+           !(every_vflag & (VIRIAL_PAIR | VIRIAL_FDOTR))) solve = 1;
+
+  // weight of the difference between the last two solves
+
+  double w = 0.0;
+  if (extrapolate_flag && every_nhistory > 1 && every_last > every_prev)
+    w = (double) (ntimestep - every_last) / (double) (every_last - every_prev);
+
+  if (!solve) {
+    for (int i = 0; i < nlocal; i++) {
+      f[i][0] += fstore[i][0] + w*(fstore[i][0] - fstore[i][3]);
+      f[i][1] += fstore[i][1] + w*(fstore[i][1] - fstore[i][4]);
+      f[i][2] += fstore[i][2] + w*(fstore[i][2] - fstore[i][5]);
+    }
+    return;
+  }
+
+  grow_private();
+  if (nlocal) memset(&f_private[0][0],0,sizeof(double)*3*nlocal);
+  private_flag = 1;
+  compute(eflag,vflag);
+  private_flag = 0;
+
+  // error of the forces that would have been used instead
+
+  if (every_nhistory > 0) {
+    double sums[2] = {0.0, 0.0};
+    for (int i = 0; i < nlocal; i++) {
+      for (int k = 0; k < 3; k++) {
+        const double delta = fstore[i][k] + w*(fstore[i][k] - fstore[i][k+3]) - f_private[i][k];
+        sums[0] += delta*delta;
+        sums[1] += f_private[i][k]*f_private[i][k];
+      }
+    }
+    double sums_all[2];
+    MPI_Allreduce(sums,sums_all,2,MPI_DOUBLE,MPI_SUM,world);
+    if (sums_all[1] > 0.0) {
+      drift_last = sqrt(sums_all[0]/sums_all[1]);
+      drift_max = MAX(drift_max,drift_last);
+      drift_sum += drift_last;
+      ndrift++;
+    }
+  }
+
+  // shift history and add new forces
+
+  for (int i = 0; i < nlocal; i++) {
+    for (int k = 0; k < 3; k++) {
+      fstore[i][k+3] = fstore[i][k];
+      fstore[i][k] = f_private[i][k];
+      f[i][k] += f_private[i][k];
+    }
+  }
+
+  every_prev = every_last;
+  every_last = ntimestep;
+  every_natoms = atom->natoms;
+  every_nhistory = MIN(every_nhistory+1,2);
+  every_eflag = eflag;
+  every_vflag = vflag;
+  nsolve_every++;
+}
+
+/* ----------------------------------------------------------------------
+   make sure the private force buffer holds all owned and ghost atoms
+------------------------------------------------------------------------- */
+
+void KSpace::grow_private()
+{
+  if (atom->nmax > nmax_private) {
+    memory->destroy(f_private);
+    nmax_private = atom->nmax;
+    memory->create(f_private,nmax_private,3,"kspace:f_private");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   force array that compute() accumulates into
+------------------------------------------------------------------------- */
+
+double **KSpace::get_force()
+{
+  if (private_flag) return f_private;
+  return atom->f;
+}
+
 /* ----------------------------------------------------------------------
    check that pair style is compatible with long-range solver
 ------------------------------------------------------------------------- */
@@ -545,6 +880,27 @@ void KSpace::modify_params(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       fftbench = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"fft") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      delete[] fft_backend;
+      if (strcmp(arg[iarg+1],"default") == 0) fft_backend = nullptr;
+      else fft_backend = utils::strdup(arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      async_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"every") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      every = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (every < 1) error->all(FLERR,"Illegal kspace_modify every value: {}",every);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"extrapolate") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (strcmp(arg[iarg+1],"none") == 0) extrapolate_flag = 0;
+      else if (strcmp(arg[iarg+1],"linear") == 0) extrapolate_flag = 1;
+      else error->all(FLERR,"Illegal kspace_modify extrapolate value: {}",arg[iarg+1]);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"collective") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       collective_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
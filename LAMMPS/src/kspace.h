@@ -30,6 +30,8 @@ class KSpace : protected Pointers {
   double e2group;            // accumulated group-group energy
   double f2group[3];         // accumulated group-group force
   int triclinic_support;     // 1 if supports triclinic geometries
+  int async_support;         // 1 if compute() can run concurrently with
+                             // pair and bond styles, see compute_async()
 
   int ewaldflag;         // 1 if a Ewald solver
   int pppmflag;          // 1 if a PPPM solver
@@ -88,7 +90,15 @@ class KSpace : protected Pointers {
   int compute_flag;       // 0 if skip compute()
   int fftbench;           // 0 if skip FFT timing
   int collective_flag;    // 1 if use MPI collectives for FFT/remap
+  char *fft_backend;      // name of 1d FFT backend, nullptr for default
   int stagger_flag;       // 1 if using staggered PPPM grids
+  int async_flag;         // 1 if run compute() concurrently with pair styles
+  int every;              // solve every this many steps, reuse forces in between
+  int extrapolate_flag;   // 1 if linearly extrapolate forces between solves
+  bigint nsolve_every, nstep_every;    // # of solves and calls of compute_every()
+  double drift_last, drift_max;        // relative rms error of reused forces
+  double drift_sum;
+  int ndrift;
 
   double splittol;    // tolerance for when to truncate splitting
 
@@ -99,6 +109,11 @@ class KSpace : protected Pointers {
   void modify_params(int, char **);
   void *extract(const char *);
   void compute_dummy(int, int);
+  int async_check();
+  void compute_async(int, int);
+  void compute_wait();
+  int every_check();
+  void compute_every(int, int);
 
   // triclinic
 
@@ -195,7 +210,22 @@ class KSpace : protected Pointers {
   int kewaldflag;                      // 1 if kspace range set for Ewald sum
   int kx_ewald, ky_ewald, kz_ewald;    // kspace settings for Ewald sum
 
+  double **f_private;    // private force buffer for async and every
+  int nmax_private;
+  int private_flag;    // 1 while compute() accumulates into f_private
+  class KSpaceAsync *async;
+
+  char *id_fix_every;                 // fix with kspace forces of last two solves
+  class FixStoreAtom *fix_every;
+  bigint every_last, every_prev;      // timesteps of last two solves
+  bigint every_natoms;                // # of atoms at last solve
+  int every_nhistory;                 // # of stored solves, 0 to 2
+  int every_eflag, every_vflag;       // energy/virial flags of last solve
+
   void pair_check();
+  double **get_force();
+  void grow_private();
+  void async_loop();
   void ev_init(int eflag, int vflag, int alloc = 1)
   {
     if (eflag || vflag)
@@ -29,11 +29,14 @@
 #include "dump.h"
 #include "error.h"
 #include "exceptions.h"
+#include "finish.h"
 #include "fix.h"
 #include "fix_external.h"
+#include "fix_viz_ring.h"
 #include "force.h"
 #include "group.h"
 #include "info.h"
+#include "integrate.h"
 #include "input.h"
 #include "lmppython.h"
 #include "memory.h"
@@ -55,6 +58,8 @@
 #include "variable.h"
 
 #include <cstring>
+#include <string>
+#include <vector>
 
 #if defined(LMP_PYTHON)
 #include <Python.h>
@@ -526,6 +531,7 @@ void lammps_file(void *handle, const char *filename)
 
   BEGIN_CAPTURE
   {
+    if (lmp->update->incremental) lammps_run_steps_end(handle);
     if (lmp->update->whichflag != 0)
       lmp->error->all(FLERR, "Issuing LAMMPS commands during a run is not allowed");
     else
@@ -563,6 +569,7 @@ char *lammps_command(void *handle, const char *cmd)
 
   BEGIN_CAPTURE
   {
+    if (lmp->update->incremental) lammps_run_steps_end(handle);
     if (lmp->update->whichflag != 0)
       lmp->error->all(FLERR, "Issuing LAMMPS command during a run is not allowed.");
     else
@@ -639,6 +646,7 @@ void lammps_commands_string(void *handle, const char *str)
 
   BEGIN_CAPTURE
   {
+    if (lmp->update->incremental) lammps_run_steps_end(handle);
     if (lmp->update->whichflag != 0) {
       lmp->error->all(FLERR, "Issuing LAMMPS commands during a run is not allowed");
     }
@@ -715,6 +723,453 @@ void lammps_commands_string(void *handle, const char *str)
   END_CAPTURE
 }
 
+/* ---------------------------------------------------------------------- */
+
+/** Advance the simulation by a number of MD steps without re-initialization.
+ *
+\verbatim embed:rst
+
+This function is meant for codes that drive LAMMPS interactively in
+small increments, e.g. a few steps per rendered frame.  Issuing ``run
+N pre no post no`` through :cpp:func:`lammps_command` for that purpose
+parses the command and goes through the run setup and the
+:cpp:class:`Finish <LAMMPS_NS::Finish>` summary on every call.
+
+The first call opens an *incremental* run: it performs the same
+initialization and setup as the :doc:`run <run>` command, but with an
+open-ended last step.  Subsequent calls only invoke
+:cpp:func:`Integrate::run() <LAMMPS_NS::Integrate::run>` and thus
+continue the time integration exactly where the previous call stopped.
+The incremental run is closed by :cpp:func:`lammps_run_steps_end` or
+implicitly before the next command is processed through
+:cpp:func:`lammps_file`, :cpp:func:`lammps_command`, or
+:cpp:func:`lammps_commands_string`.
+
+Since the last step of an incremental run is not known in advance,
+fixes that ramp a quantity between the first and last step of a run
+(e.g. a thermostat with different start and stop temperatures) will
+stay at their start value.
+
+\endverbatim
+ *
+ * \param  handle  pointer to a previously created LAMMPS instance
+ * \param  nsteps  number of MD steps to advance
+ * \return         number of steps completed, which is smaller than
+ *                 *nsteps* if a timeout was triggered */
+
+int lammps_run_steps(void *handle, int nsteps)
+{
+  auto lmp = (LAMMPS *) handle;
+  Update *update = lmp->update;
+  bigint start = update->ntimestep;
+
+  BEGIN_CAPTURE
+  {
+    if (lmp->domain->box_exist == 0)
+      lmp->error->all(FLERR, "Run steps before simulation box is defined");
+    if (nsteps < 0)
+      lmp->error->all(FLERR, "Invalid number of run steps: {}", nsteps);
+    if ((update->whichflag != 0) && !update->incremental)
+      lmp->error->all(FLERR, "Cannot start an incremental run during a run");
+
+    // re-open the incremental run if it would go past its last step
+
+    if (update->incremental && (update->ntimestep + nsteps > update->laststep))
+      lammps_run_steps_end(handle);
+
+    if (!update->incremental) {
+      update->whichflag = 1;
+      update->incremental = 1;
+      lmp->timer->init_timeout();
+
+      update->nsteps = MAXSMALLINT;
+      update->firststep = update->beginstep = update->ntimestep;
+      update->laststep = update->endstep = update->ntimestep + MAXSMALLINT;
+
+      lmp->init();
+      update->integrate->setup(1);
+
+      lmp->timer->init();
+      lmp->timer->barrier_start();
+    }
+
+    if (!lmp->timer->is_timeout()) update->integrate->run(nsteps);
+  }
+  END_CAPTURE
+
+  return (int) (update->ntimestep - start);
+}
+
+/* ---------------------------------------------------------------------- */
+
+/** Advance the simulation for as many MD steps as fit into a wall time budget.
+ *
+\verbatim embed:rst
+
+This works like :cpp:func:`lammps_run_steps`, but stops as soon as the
+next step is expected to end after *seconds* of wall time have passed
+since the call.  The duration of the previous step serves as estimate,
+the check is done between steps so the system is always left in a
+consistent state.  At least one step is done per call, so the
+simulation makes progress even if a single step takes longer than the
+budget.  This allows a renderer to spend a fixed share of each frame on
+the simulation, e.g. 8 ms of an 11 ms frame at 90 Hz, and get the
+largest number of steps that fits.
+
+\endverbatim
+ *
+ * \param  handle    pointer to a previously created LAMMPS instance
+ * \param  seconds   wall time budget in seconds
+ * \param  maxsteps  upper limit for the number of MD steps
+ * \return           number of steps completed */
+
+int lammps_run_budget(void *handle, double seconds, int maxsteps)
+{
+  auto lmp = (LAMMPS *) handle;
+  Timer *timer = lmp->timer;
+
+  // a newly opened incremental run does its setup before the budget starts
+
+  if (!lmp->update->incremental) lammps_run_steps(handle, 0);
+
+  timer->init_budget(seconds);
+  int nsteps = lammps_run_steps(handle, maxsteps);
+  timer->clear_budget();
+
+  return nsteps;
+}
+
+/* ---------------------------------------------------------------------- */
+
+/** Close an incremental run opened by lammps_run_steps().
+ *
+\verbatim embed:rst
+
+This performs the cleanup of the integrator and prints the loop time
+summary, equivalent to the end of a ``run N post no`` command.  The
+function does nothing if no incremental run is open.
+
+\endverbatim
+ *
+ * \param  handle  pointer to a previously created LAMMPS instance */
+
+void lammps_run_steps_end(void *handle)
+{
+  auto lmp = (LAMMPS *) handle;
+  Update *update = lmp->update;
+
+  BEGIN_CAPTURE
+  {
+    if (update->incremental) {
+      lmp->timer->barrier_stop();
+
+      update->nsteps = (int) (update->ntimestep - update->firststep);
+      update->laststep = update->endstep = update->ntimestep;
+      update->integrate->cleanup();
+
+      Finish finish(lmp);
+      finish.end(0);
+
+      update->incremental = 0;
+      update->whichflag = 0;
+      update->firststep = update->laststep = 0;
+      update->beginstep = update->endstep = 0;
+    }
+  }
+  END_CAPTURE
+}
+
+/* ---------------------------------------------------------------------- */
+
+// state of a LAMMPS instance captured by lammps_snapshot_create()
+
+namespace {
+struct LammpsSnapshot {
+  LAMMPS *lmp;
+  bigint ntimestep, atimestep;
+  double atime;
+  double boxlo[3], boxhi[3];
+  double xy, xz, yz;
+  bigint natoms, nbonds, nangles, ndihedrals, nimpropers;
+  std::vector<double> atoms;          // owned atoms packed with AtomVec::pack_exchange()
+  std::vector<std::string> fixes;     // ID and style of all fixes
+  std::vector<std::string> state;     // global restart data of fixes with restart_global
+};
+
+constexpr int SNAPSHOT_BUFEXTRA = 1024;
+}    // namespace
+
+// capture what Fix::write_restart() writes without going through a file
+
+static std::string write_fix_state(Fix *fix)
+{
+  std::string state;
+#if defined(_WIN32)
+  FILE *fp = tmpfile();
+  if (!fp) return state;
+  fix->write_restart(fp);
+  long len = ftell(fp);
+  if (len > 0) {
+    state.resize(len);
+    rewind(fp);
+    if (fread(&state[0], 1, len, fp) != (size_t) len) state.clear();
+  }
+  fclose(fp);
+#else
+  char *data = nullptr;
+  size_t len = 0;
+  FILE *fp = open_memstream(&data, &len);
+  if (!fp) return state;
+  fix->write_restart(fp);
+  fclose(fp);
+  state.assign(data, len);
+  free(data);
+#endif
+  return state;
+}
+
+/** Capture the current state of a LAMMPS instance in memory.
+ *
+\verbatim embed:rst
+
+The snapshot holds the per-atom data of all owned atoms, including
+per-atom data that fixes store with the atoms, the simulation box, the
+timestep and the global state of fixes that is also written to restart
+files (e.g. thermostat variables of fix nvt).  Potential parameters,
+pair coefficients, and the definitions of fixes and computes are not
+copied, they stay with the instance.  A snapshot taken after setting up
+a system can thus be restored with :cpp:func:`lammps_snapshot_restore`
+to reset the simulation without reading the input, data, and potential
+files again.
+
+The snapshot must be released with :cpp:func:`lammps_snapshot_free`.
+
+\endverbatim
+ *
+ * \param  handle  pointer to a previously created LAMMPS instance
+ * \return         pointer to the snapshot or ``NULL`` on failure */
+
+void *lammps_snapshot_create(void *handle)
+{
+  auto lmp = (LAMMPS *) handle;
+  LammpsSnapshot *snapshot = nullptr;
+
+  BEGIN_CAPTURE
+  {
+    Atom *atom = lmp->atom;
+    Domain *domain = lmp->domain;
+    Update *update = lmp->update;
+
+    if (domain->box_exist == 0)
+      lmp->error->all(FLERR, "Snapshot command before simulation box is defined");
+    if (update->whichflag && !update->incremental)
+      lmp->error->all(FLERR, "Snapshot cannot be taken during a run");
+
+    snapshot = new LammpsSnapshot;
+    snapshot->lmp = lmp;
+    snapshot->ntimestep = update->ntimestep;
+    snapshot->atimestep = update->atimestep;
+    snapshot->atime = update->atime;
+
+    for (int dim = 0; dim < 3; dim++) {
+      snapshot->boxlo[dim] = domain->boxlo[dim];
+      snapshot->boxhi[dim] = domain->boxhi[dim];
+    }
+    snapshot->xy = domain->xy;
+    snapshot->xz = domain->xz;
+    snapshot->yz = domain->yz;
+
+    snapshot->natoms = atom->natoms;
+    snapshot->nbonds = atom->nbonds;
+    snapshot->nangles = atom->nangles;
+    snapshot->ndihedrals = atom->ndihedrals;
+    snapshot->nimpropers = atom->nimpropers;
+
+    // pack owned atoms the same way they migrate between processes
+
+    int maxone = atom->avec->maxexchange + SNAPSHOT_BUFEXTRA;
+    for (const auto &fix : lmp->modify->get_fix_list()) maxone += fix->maxexchange;
+    std::vector<double> &buf = snapshot->atoms;
+    size_t m = 0;
+    for (int i = 0; i < atom->nlocal; i++) {
+      if (buf.size() < m + maxone) buf.resize(2 * (m + maxone));
+      m += atom->avec->pack_exchange(i, &buf[m]);
+    }
+    buf.resize(m);
+
+    for (const auto &fix : lmp->modify->get_fix_list()) {
+      snapshot->fixes.push_back(std::string(fix->id) + " " + fix->style);
+      if (fix->restart_global) snapshot->state.push_back(write_fix_state(fix));
+    }
+  }
+  END_CAPTURE
+
+  return (void *) snapshot;
+}
+
+/* ---------------------------------------------------------------------- */
+
+/** Reset a LAMMPS instance to the state captured by lammps_snapshot_create().
+ *
+\verbatim embed:rst
+
+Restoring replaces all owned atoms, the simulation box, the timestep
+and the global fix state with the contents of the snapshot.  This is a
+copy of in-memory data, the next run performs the usual setup with
+neighbor list builds.  An open incremental run of
+:cpp:func:`lammps_run_steps` is closed first.
+
+The snapshot can only be restored into the LAMMPS instance it was taken
+from and only if the same fixes are defined as at the time it was
+taken.  Since the random number generator state of fixes is not part
+of restart data, stochastic fixes will not reproduce the trajectory
+after the snapshot.  As with the :doc:`reset_timestep <reset_timestep>`
+command, no dump may be defined; restoring fails otherwise.
+
+\endverbatim
+ *
+ * \param  handle    pointer to a previously created LAMMPS instance
+ * \param  snapshot  pointer returned by lammps_snapshot_create()
+ * \return           0 on success, -1 on failure */
+
+int lammps_snapshot_restore(void *handle, void *snapshot)
+{
+  auto lmp = (LAMMPS *) handle;
+  auto snap = (LammpsSnapshot *) snapshot;
+  int rv = -1;
+
+  BEGIN_CAPTURE
+  {
+    Atom *atom = lmp->atom;
+    Domain *domain = lmp->domain;
+    Update *update = lmp->update;
+
+    if (!snap || (snap->lmp != lmp))
+      lmp->error->all(FLERR, "Snapshot was not taken from this LAMMPS instance");
+    if (update->incremental) lammps_run_steps_end(handle);
+    if (update->whichflag) lmp->error->all(FLERR, "Snapshot cannot be restored during a run");
+    if (lmp->output->ndump > 0)
+      lmp->error->all(FLERR, "Snapshot cannot be restored while a dump is defined");
+
+    // the packed per-atom data depends on the fixes storing data with the atoms
+
+    const auto &fixes = lmp->modify->get_fix_list();
+    bool same = fixes.size() == snap->fixes.size();
+    for (std::size_t i = 0; same && (i < fixes.size()); i++)
+      same = snap->fixes[i] == std::string(fixes[i]->id) + " " + fixes[i]->style;
+    if (!same) lmp->error->all(FLERR, "Snapshot cannot be restored after fixes were changed");
+
+    for (int dim = 0; dim < 3; dim++) {
+      domain->boxlo[dim] = snap->boxlo[dim];
+      domain->boxhi[dim] = snap->boxhi[dim];
+    }
+    domain->xy = snap->xy;
+    domain->xz = snap->xz;
+    domain->yz = snap->yz;
+    domain->set_initial_box();
+    domain->set_global_box();
+    domain->set_local_box();
+
+    // replace owned atoms and drop ghosts, they are recreated by the next setup
+
+    if (atom->map_style != Atom::MAP_NONE) atom->map_clear();
+    atom->nlocal = 0;
+    atom->nghost = 0;
+    atom->avec->clear_bonus();
+
+    const std::vector<double> &buf = snap->atoms;
+    size_t m = 0;
+    while (m < buf.size()) m += atom->avec->unpack_exchange(const_cast<double *>(&buf[m]));
+
+    atom->natoms = snap->natoms;
+    atom->nbonds = snap->nbonds;
+    atom->nangles = snap->nangles;
+    atom->ndihedrals = snap->ndihedrals;
+    atom->nimpropers = snap->nimpropers;
+
+    if (atom->map_style != Atom::MAP_NONE) {
+      atom->map_init();
+      atom->map_set();
+    }
+
+    // global fix state is only written by MPI rank 0, as in restart files
+
+    std::size_t istate = 0;
+    for (auto &fix : fixes) {
+      if (!fix->restart_global) continue;
+      std::string state = snap->state[istate++];
+      int n = state.size();
+      MPI_Bcast(&n, 1, MPI_INT, 0, lmp->world);
+      state.resize(n);
+      if (n) MPI_Bcast(&state[0], n, MPI_CHAR, 0, lmp->world);
+      if (n > (int) sizeof(int)) fix->restart(&state[sizeof(int)]);
+    }
+
+    update->reset_timestep(snap->ntimestep, false);
+    update->atimestep = snap->atimestep;
+    update->atime = snap->atime;
+    rv = 0;
+  }
+  END_CAPTURE
+
+  return rv;
+}
+
+/* ---------------------------------------------------------------------- */
+
+/** Delete a snapshot created by lammps_snapshot_create().
+ *
+ * \param  snapshot  pointer returned by lammps_snapshot_create() */
+
+void lammps_snapshot_free(void *snapshot)
+{
+  delete (LammpsSnapshot *) snapshot;
+}
+
+/* ---------------------------------------------------------------------- */
+
+/** Set the number of OpenMP threads used by a LAMMPS instance.
+ *
+\verbatim embed:rst
+
+This issues the equivalent of a ``package omp`` command and, for more
+than one thread, enables the ``omp`` suffix, so that styles with a
+threaded variant in the OPENMP package (e.g. ``pair_style vashishta``)
+use it, while all other styles fall back to their regular version.
+With a single thread a previously enabled ``omp`` suffix is turned off
+again.  Like the ``package`` command, this must be called before the
+simulation box is defined.  If LAMMPS was compiled without OpenMP
+support, this does nothing and one thread is used.
+
+\endverbatim
+ *
+ * \param  handle    pointer to a previously created LAMMPS instance
+ * \param  nthreads  requested number of threads
+ * \return           number of threads used, 0 on error */
+
+int lammps_set_threads(void *handle, int nthreads)
+{
+  auto lmp = (LAMMPS *) handle;
+  int nused = 0;
+
+  BEGIN_CAPTURE
+  {
+    if (lmp->domain->box_exist)
+      lmp->error->all(FLERR, "Thread count must be set before simulation box is defined");
+    if (nthreads < 1) lmp->error->all(FLERR, "Invalid number of threads: {}", nthreads);
+
+#if defined(LMP_OPENMP)
+    lmp->input->one(fmt::format("package omp {}", nthreads));
+    if (lmp->comm->nthreads > 1) lmp->input->one("suffix omp");
+    else if (lmp->suffix && (strcmp(lmp->suffix,"omp") == 0)) lmp->input->one("suffix off");
+#endif
+    nused = lmp->comm->nthreads;
+  }
+  END_CAPTURE
+
+  return nused;
+}
+
 // -----------------------------------------------------------------------
 // Library functions to extract info from LAMMPS or set data in LAMMPS
 // -----------------------------------------------------------------------
@@ -2834,6 +3289,424 @@ void lammps_gather_atoms(void *handle, const char *name, int type, int count, vo
   END_CAPTURE
 }
 
+/* ----------------------------------------------------------------------
+   gather wrapped positions by atom ID into data, shared by
+   lammps_gather_positions_wrapped() and lammps_encode_positions_quantized()
+   returns 0 without touching data if atom IDs are missing or not consecutive
+------------------------------------------------------------------------- */
+
+#if !defined(LAMMPS_BIGBIG)
+static int gather_positions_wrapped(LAMMPS *lmp, double *data)
+{
+  int flag = 0;
+  if (lmp->atom->tag_enable == 0 || lmp->atom->tag_consecutive() == 0)
+    flag = 1;
+  if (lmp->atom->natoms > MAXSMALLINT) flag = 1;
+  if (flag) return 0;
+
+  int natoms = static_cast<int> (lmp->atom->natoms);
+
+  // copy = Natom length vector of positions, inserted by atom ID
+  // MPI_Allreduce with MPI_SUM to merge into data, then remap in one pass
+
+  double *copy;
+  lmp->memory->create(copy,3*natoms,"lib/gather:copy");
+  for (int i = 0; i < 3*natoms; i++) copy[i] = 0.0;
+
+  double **x = lmp->atom->x;
+  tagint *tag = lmp->atom->tag;
+  int nlocal = lmp->atom->nlocal;
+
+  for (int i = 0; i < nlocal; i++) {
+    int offset = 3*(tag[i]-1);
+    copy[offset] = x[i][0];
+    copy[offset+1] = x[i][1];
+    copy[offset+2] = x[i][2];
+  }
+
+  MPI_Allreduce(copy,data,3*natoms,MPI_DOUBLE,MPI_SUM,lmp->world);
+  lmp->memory->destroy(copy);
+
+  lmp->domain->remap_all(natoms,data);
+  return 1;
+}
+#endif
+
+/** Gather the positions of all atoms remapped into the periodic box, in order.
+ *
+\verbatim embed:rst
+
+This function works like :cpp:func:`lammps_gather_atoms` with *name* =
+*x*, *type* = 1 and *count* = 3, but in addition wraps the gathered
+positions back into the periodic simulation box.  This is what
+visualization clients typically need: the per-atom coordinates are only
+remapped during reneighboring and thus may be slightly outside the box,
+and their storage order changes whenever atoms are sorted or migrate.
+
+The positions are placed by atom ID, so no sort or atom map is needed.
+The remap is applied to all atoms at once with
+:cpp:func:`Domain::remap_all() <LAMMPS_NS::Domain::remap_all>` for
+orthogonal and triclinic boxes.  *data* must be pre-allocated by the
+caller to length 3 :math:`\times` *natoms*.
+
+.. admonition:: Restrictions
+    :class: warning
+
+    This function is not compatible with ``-DLAMMPS_BIGBIG``.
+
+    Atom IDs must be defined and consecutive.
+
+    The total number of atoms must not be more than 2147483647 (max 32-bit signed int).
+
+\endverbatim
+ *
+ * \param handle  pointer to a previously created LAMMPS instance
+ * \param data    wrapped positions packed in a 1-dimensional array of length
+ *                *natoms* \* 3. */
+
+void lammps_gather_positions_wrapped(void *handle, double *data)
+{
+  auto lmp = (LAMMPS *) handle;
+
+  BEGIN_CAPTURE
+  {
+#if defined(LAMMPS_BIGBIG)
+    lmp->error->all(FLERR,"Library function lammps_gather_positions_wrapped() "
+                    "is not compatible with -DLAMMPS_BIGBIG");
+#else
+    if (!gather_positions_wrapped(lmp, data)) {
+      lmp->error->all(FLERR,"lammps_gather_positions_wrapped(): "
+                      "Atom-IDs must exist and be consecutive");
+      return;
+    }
+#endif
+  }
+  END_CAPTURE
+}
+
+/* ---------------------------------------------------------------------- */
+
+// header of a quantized position frame: magic, keyframe flag, natoms,
+// boxlo[3], h[6], followed by the per-coordinate payload.
+// all values are stored little-endian, independent of the host
+
+static constexpr char QUANT_MAGIC[4] = {'L', 'M', 'P', 'Q'};
+static constexpr int QUANT_HEADER = 4 + 2 * sizeof(int32_t) + 9 * sizeof(double);
+
+static unsigned char *quant_put(unsigned char *ptr, uint64_t value, int nbytes)
+{
+  for (int i = 0; i < nbytes; i++) *ptr++ = (value >> (8*i)) & 0xff;
+  return ptr;
+}
+
+static const unsigned char *quant_get(const unsigned char *ptr, uint64_t &value, int nbytes)
+{
+  value = 0;
+  for (int i = 0; i < nbytes; i++) value |= static_cast<uint64_t> (*ptr++) << (8*i);
+  return ptr;
+}
+
+/** Encode the positions of all atoms as 16-bit quantized box-fractional
+ * coordinates, optionally delta-encoded against the previous frame.
+ *
+\verbatim embed:rst
+
+This function produces a compact frame for streaming positions to
+visualization clients, which typically need only about :math:`10^{-3}`
+precision relative to the box size.  The wrapped positions (see
+:cpp:func:`lammps_gather_positions_wrapped`) are converted to fractional
+box coordinates and quantized to 16 bits, i.e. a resolution of
+:math:`1/65536` of the box edge.
+
+A frame starts with an 84 byte header with the box geometry and atom
+count, stored little-endian like the payload.  For a *keyframe* the header is followed by the quantized
+coordinates as little-endian 16-bit integers, 6 bytes per atom.  For
+other frames each coordinate is stored as the difference to the
+quantized value in *state*, modulo :math:`2^{16}` so that atoms crossing
+a periodic boundary still produce a small value, zig-zag and variable
+length encoded.  For typical per-frame displacements that is one byte
+per coordinate.  After encoding, *state* holds the quantized positions
+of this frame.  The frames are decoded with
+:cpp:func:`lammps_decode_positions_quantized`.
+
+The *buffer* must have room for the worst case of 84 + 9 :math:`\times`
+*natoms* bytes.  The same restrictions as for
+:cpp:func:`lammps_gather_atoms` apply.
+
+\endverbatim
+ *
+ * \param handle    pointer to a previously created LAMMPS instance
+ * \param keyframe  1 to write absolute values, 0 to write deltas against *state*
+ * \param state     quantized positions of the previous frame, 3 \* *natoms*
+ *                  values, updated on return
+ * \param buffer    byte buffer receiving the encoded frame
+ * \param bufsize   size of *buffer* in bytes
+ * \return          number of bytes written to *buffer* or 0 on error */
+
+int lammps_encode_positions_quantized(void *handle, int keyframe, uint16_t *state,
+                                      unsigned char *buffer, int bufsize)
+{
+  auto lmp = (LAMMPS *) handle;
+  int nbytes = 0;
+
+  BEGIN_CAPTURE
+  {
+    if (lmp->atom->natoms > (MAXSMALLINT - QUANT_HEADER) / 9)
+      lmp->error->all(FLERR,"lammps_encode_positions_quantized(): Too many atoms");
+
+    int natoms = static_cast<int> (lmp->atom->natoms);
+    if (bufsize < QUANT_HEADER + 9 * natoms)
+      lmp->error->all(FLERR,"lammps_encode_positions_quantized(): Buffer too small");
+
+#if defined(LAMMPS_BIGBIG)
+    lmp->error->all(FLERR,"Library function lammps_encode_positions_quantized() "
+                    "is not compatible with -DLAMMPS_BIGBIG");
+#else
+    double *x;
+    lmp->memory->create(x,3*natoms,"lib/quantize:x");
+    if (!gather_positions_wrapped(lmp,x)) {
+      lmp->memory->destroy(x);
+      lmp->error->all(FLERR,"lammps_encode_positions_quantized(): "
+                      "Atom-IDs must exist and be consecutive");
+      return 0;
+    }
+
+    Domain *domain = lmp->domain;
+    double box[9] = {domain->boxlo[0], domain->boxlo[1], domain->boxlo[2],
+                     domain->h[0], domain->h[1], domain->h[2],
+                     domain->h[3], domain->h[4], domain->h[5]};
+
+    unsigned char *ptr = buffer;
+    memcpy(ptr, QUANT_MAGIC, 4);
+    ptr += 4;
+    ptr = quant_put(ptr, keyframe ? 1 : 0, sizeof(int32_t));
+    ptr = quant_put(ptr, static_cast<uint32_t> (natoms), sizeof(int32_t));
+    for (double value : box) {
+      uint64_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      ptr = quant_put(ptr, bits, sizeof(bits));
+    }
+
+    double lamda[3];
+    for (int i = 0; i < natoms; i++) {
+      domain->x2lamda(&x[3*i], lamda);
+      for (int dim = 0; dim < 3; dim++) {
+        // clamp, since atoms may be outside the box in non-periodic dims
+
+        double frac = MAX(0.0, MIN(lamda[dim], 1.0));
+        auto q = static_cast<uint16_t> (MIN(65535.0, frac * 65536.0));
+        uint16_t &prev = state[3*i+dim];
+
+        if (keyframe) {
+          *ptr++ = q & 0xff;
+          *ptr++ = q >> 8;
+        } else {
+          auto delta = static_cast<int16_t> (static_cast<uint16_t> (q - prev));
+          auto zigzag = static_cast<uint16_t> ((static_cast<uint16_t> (delta) << 1) ^ (delta >> 15));
+          while (zigzag >= 0x80) {
+            *ptr++ = (zigzag & 0x7f) | 0x80;
+            zigzag >>= 7;
+          }
+          *ptr++ = zigzag;
+        }
+        prev = q;
+      }
+    }
+
+    lmp->memory->destroy(x);
+    nbytes = static_cast<int> (ptr - buffer);
+#endif
+  }
+  END_CAPTURE
+
+  return nbytes;
+}
+
+/* ---------------------------------------------------------------------- */
+
+/** Decode a frame written by lammps_encode_positions_quantized().
+ *
+\verbatim embed:rst
+
+This function does not need a LAMMPS instance, so it can be used by
+lightweight viewers.  It reconstructs positions at the center of each
+quantization interval, so the error is at most :math:`1/131072` of the
+respective box edge.  A delta frame can only be decoded if *state*
+holds the quantized positions of the preceding frame, which is the
+case after decoding it.  Call with *state* and *x* set to ``NULL`` to
+only query the number of atoms in the frame.
+
+The frame is treated as untrusted input: it is rejected if its atom
+count is negative or exceeds *capacity*, or if *bufsize* is too small
+for the payload of that many atoms.
+
+\endverbatim
+ *
+ * \param buffer    encoded frame
+ * \param bufsize   size of the encoded frame in bytes
+ * \param state     quantized positions of the previous frame, 3 \* *natoms*
+ *                  values, updated on return
+ * \param x         decoded positions, 3 \* *natoms* values
+ * \param capacity  number of atoms *state* and *x* have room for
+ * \return          number of atoms in the frame or -1 if the frame is invalid
+ *                  or does not fit */
+
+int lammps_decode_positions_quantized(const unsigned char *buffer, int bufsize,
+                                      uint16_t *state, double *x, int capacity)
+{
+  if (bufsize < QUANT_HEADER || memcmp(buffer, QUANT_MAGIC, 4) != 0) return -1;
+
+  uint64_t value;
+  double box[9];
+  const unsigned char *ptr = buffer + 4;
+  const unsigned char *end = buffer + bufsize;
+  ptr = quant_get(ptr, value, sizeof(int32_t));
+  int keyframe = static_cast<int32_t> (value);
+  ptr = quant_get(ptr, value, sizeof(int32_t));
+  int natoms = static_cast<int32_t> (value);
+  for (double &b : box) {
+    ptr = quant_get(ptr, value, sizeof(value));
+    memcpy(&b, &value, sizeof(b));
+  }
+
+  // a keyframe has 2 bytes per coordinate, a delta frame at least 1
+
+  if ((natoms < 0) || (natoms > (MAXSMALLINT - QUANT_HEADER) / 9)) return -1;
+  if (bufsize < QUANT_HEADER + (keyframe ? 6 : 3) * natoms) return -1;
+  if (!state || !x) return natoms;
+  if (natoms > capacity) return -1;
+
+  const double *lo = box;
+  const double *h = box + 3;
+  double lamda[3];
+
+  for (int i = 0; i < natoms; i++) {
+    for (int dim = 0; dim < 3; dim++) {
+      uint16_t &q = state[3*i+dim];
+
+      if (keyframe) {
+        if (end - ptr < 2) return -1;
+        q = static_cast<uint16_t> (ptr[0] | (ptr[1] << 8));
+        ptr += 2;
+      } else {
+        unsigned int zigzag = 0;
+        int shift = 0;
+        do {
+          if ((ptr == end) || (shift > 14)) return -1;
+          zigzag |= (*ptr & 0x7f) << shift;
+          shift += 7;
+        } while (*ptr++ & 0x80);
+        auto delta = static_cast<int16_t> ((zigzag >> 1) ^ -(zigzag & 1));
+        q = static_cast<uint16_t> (q + delta);
+      }
+      lamda[dim] = (q + 0.5) / 65536.0;
+    }
+
+    x[3*i]   = h[0]*lamda[0] + h[5]*lamda[1] + h[4]*lamda[2] + lo[0];
+    x[3*i+1] = h[1]*lamda[1] + h[3]*lamda[2] + lo[1];
+    x[3*i+2] = h[2]*lamda[2] + lo[2];
+  }
+
+  return natoms;
+}
+
+/* ---------------------------------------------------------------------- */
+
+/** Map the shared memory ring written by a fix viz/ring for reading.
+ *
+\verbatim embed:rst
+
+This function does not need a LAMMPS instance and is meant to be called
+by a viewer, possibly in another process than the one running the
+simulation.  The ring is mapped read-only, frames are accessed in place
+with :cpp:func:`lammps_viz_ring_latest` without any copying or locking.
+
+\endverbatim
+ *
+ * \param  name  name of the shared memory segment as given to fix viz/ring
+ * \return       handle to the mapped ring or ``NULL`` if it cannot be opened */
+
+void *lammps_viz_ring_open(const char *name)
+{
+  if (!name || !name[0]) return nullptr;
+  return (void *) FixVizRing::open_reader(name);
+}
+
+/* ---------------------------------------------------------------------- */
+
+/** Unmap a ring opened with lammps_viz_ring_open().
+ *
+ * \param  ring  handle returned by lammps_viz_ring_open() */
+
+void lammps_viz_ring_close(void *ring)
+{
+  FixVizRing::close_reader((VizRingHeader *) ring);
+}
+
+/* ---------------------------------------------------------------------- */
+
+/** Return a pointer to the most recent complete frame in a viz/ring.
+ *
+\verbatim embed:rst
+
+The returned data points directly into the shared memory segment and
+holds *natoms* rows of *ncols* doubles each, the first column being the
+atom ID followed by the values requested in the fix viz/ring command.
+The writer never waits for readers, so the slot may be overwritten
+while it is being read.  After consuming the data, call
+:cpp:func:`lammps_viz_ring_valid` with the returned frame number and
+discard the data if it returns 0.
+
+\endverbatim
+ *
+ * \param ring      handle returned by lammps_viz_ring_open()
+ * \param frame     set to the frame number, may be ``NULL``
+ * \param timestep  set to the timestep of the frame, may be ``NULL``
+ * \param boxlo     set to the lower box corner, 3 values, may be ``NULL``
+ * \param h         set to the box shape matrix in Voigt order, 6 values, may be ``NULL``
+ * \param natoms    set to the number of atoms in the frame, may be ``NULL``
+ * \param ncols     set to the number of values per atom, may be ``NULL``
+ * \return          pointer to the per-atom data or ``NULL`` if no frame is available */
+
+const double *lammps_viz_ring_latest(void *ring, int64_t *frame, int64_t *timestep,
+                                     double *boxlo, double *h, int *natoms, int *ncols)
+{
+  auto header = (VizRingHeader *) ring;
+  if (!header) return nullptr;
+
+  int64_t latest = header->latest.load(std::memory_order_acquire);
+  if (latest < 0) return nullptr;
+
+  VizRingSlot *slot = FixVizRing::get_slot(header, latest);
+  if (slot->seq.load(std::memory_order_acquire) != 2 * latest + 2) return nullptr;
+
+  if (frame) *frame = latest;
+  if (timestep) *timestep = slot->timestep;
+  if (boxlo) memcpy(boxlo, slot->boxlo, sizeof(slot->boxlo));
+  if (h) memcpy(h, slot->h, sizeof(slot->h));
+  if (natoms) *natoms = static_cast<int> (slot->natoms);
+  if (ncols) *ncols = header->ncols;
+  return (const double *) (slot + 1);
+}
+
+/* ---------------------------------------------------------------------- */
+
+/** Check whether a frame in a viz/ring is still intact.
+ *
+ * \param ring   handle returned by lammps_viz_ring_open()
+ * \param frame  frame number returned by lammps_viz_ring_latest()
+ * \return       1 if the frame was not overwritten since it was returned, 0 otherwise */
+
+int lammps_viz_ring_valid(void *ring, int64_t frame)
+{
+  auto header = (VizRingHeader *) ring;
+  if (!header || frame < 0) return 0;
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  VizRingSlot *slot = FixVizRing::get_slot(header, frame);
+  return (slot->seq.load(std::memory_order_relaxed) == 2 * frame + 2) ? 1 : 0;
+}
+
 /** Gather the named atom-based entity for all atoms across all processes,
  * unordered.
  *
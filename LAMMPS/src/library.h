@@ -34,9 +34,7 @@
 #include <mpi.h>
 #endif
 
-#if defined(LAMMPS_BIGBIG) || defined(LAMMPS_SMALLBIG)
-#include <stdint.h> /* for int64_t */
-#endif
+#include <stdint.h> /* for int64_t and uint16_t */
 
 /** Data type constants for extracting data from atoms, computes and fixes
  *
@@ -143,6 +141,14 @@ char *lammps_command(void *handle, const char *cmd);
 void lammps_commands_list(void *handle, int ncmd, const char **cmds);
 void lammps_commands_string(void *handle, const char *str);
 
+int lammps_run_steps(void *handle, int nsteps);
+int lammps_run_budget(void *handle, double seconds, int maxsteps);
+void lammps_run_steps_end(void *handle);
+void *lammps_snapshot_create(void *handle);
+int lammps_snapshot_restore(void *handle, void *snapshot);
+void lammps_snapshot_free(void *snapshot);
+int lammps_set_threads(void *handle, int nthreads);
+
 /* -----------------------------------------------------------------------
  * Library functions to extract info from LAMMPS or set data in LAMMPS
  * ----------------------------------------------------------------------- */
@@ -189,6 +195,16 @@ int lammps_variable_info(void *handle, int idx, char *buf, int bufsize);
  * ---------------------------------------------------------------------- */
 
 void lammps_gather_atoms(void *handle, const char *name, int type, int count, void *data);
+void lammps_gather_positions_wrapped(void *handle, double *data);
+int lammps_encode_positions_quantized(void *handle, int keyframe, uint16_t *state,
+                                      unsigned char *buffer, int bufsize);
+int lammps_decode_positions_quantized(const unsigned char *buffer, int bufsize,
+                                      uint16_t *state, double *x, int capacity);
+void *lammps_viz_ring_open(const char *name);
+void lammps_viz_ring_close(void *ring);
+const double *lammps_viz_ring_latest(void *ring, int64_t *frame, int64_t *timestep,
+                                     double *boxlo, double *h, int *natoms, int *ncols);
+int lammps_viz_ring_valid(void *ring, int64_t frame);
 void lammps_gather_atoms_concat(void *handle, const char *name, int type, int count, void *data);
 void lammps_gather_atoms_subset(void *handle, const char *name, int type, int count, int ndata,
                                 int *ids, void *data);
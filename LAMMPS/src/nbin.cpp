@@ -32,6 +32,12 @@ NBin::NBin(LAMMPS *lmp) : Pointers(lmp)
   bins = nullptr;
   atom2bin = nullptr;
 
+  bin2rank = nullptr;
+  binstart = nullptr;
+  binpack = nullptr;
+  atom2pos = nullptr;
+  binx = nullptr;
+
   nbinx_multi = nullptr; nbiny_multi = nullptr; nbinz_multi = nullptr;
   mbins_multi = nullptr;
   mbinx_multi = nullptr; mbiny_multi = nullptr, mbinz_multi = nullptr;
@@ -63,6 +69,12 @@ NBin::~NBin()
   memory->destroy(bins);
   memory->destroy(atom2bin);
 
+  memory->destroy(bin2rank);
+  memory->destroy(binstart);
+  memory->destroy(binpack);
+  memory->destroy(atom2pos);
+  memory->destroy(binx);
+
   if (!binhead_multi) return;
 
   memory->destroy(nbinx_multi);
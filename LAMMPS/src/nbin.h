@@ -38,6 +38,14 @@ class NBin : protected Pointers {
   int *bins;        // index of next atom in same bin
   int *atom2bin;    // bin assignment for each atom (local+ghost)
 
+  // Variables for NBinSorted
+
+  int *bin2rank;    // rank of each bin along the Morton curve
+  int *binstart;    // offset of each ranked bin in binpack, mbins+1 long
+  int *binpack;     // binned atoms, contiguous per bin
+  int *atom2pos;    // index into binpack for each atom (local+ghost)
+  double *binx;     // coords of binned atoms in binpack order
+
   // Analogues for NBinMultimulti
 
   int *nbinx_multi, *nbiny_multi, *nbinz_multi;
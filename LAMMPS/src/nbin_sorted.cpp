@@ -0,0 +1,158 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "nbin_sorted.h"
+#include "atom.h"
+#include "group.h"
+#include "memory.h"
+#include "update.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+NBinSorted::NBinSorted(LAMMPS *lmp) : NBinStandard(lmp)
+{
+  maxrank = maxpack = maxstart = 0;
+  rankx = ranky = rankz = 0;
+}
+
+/* ----------------------------------------------------------------------
+   setup for bin_atoms(), also grow packed per-bin arrays
+------------------------------------------------------------------------- */
+
+void NBinSorted::bin_atoms_setup(int nall)
+{
+  NBinStandard::bin_atoms_setup(nall);
+
+  if (mbins+1 > maxstart) {
+    maxstart = mbins+1;
+    memory->destroy(binstart);
+    memory->create(binstart,maxstart,"neigh:binstart");
+  }
+
+  if (nall > maxpack) {
+    maxpack = maxatom;
+    memory->destroy(binpack);
+    memory->create(binpack,maxpack,"neigh:binpack");
+    memory->destroy(atom2pos);
+    memory->create(atom2pos,maxpack,"neigh:atom2pos");
+    memory->destroy(binx);
+    memory->create(binx,3*maxpack,"neigh:binx");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   setup neighbor binning geometry, then rank local bins along Morton curve
+   the extra bin past mbinx*mbiny*mbinz keeps its place at the end
+------------------------------------------------------------------------- */
+
+void NBinSorted::setup_bins(int style)
+{
+  NBinStandard::setup_bins(style);
+
+  if (mbins > maxrank) {
+    maxrank = mbins;
+    memory->destroy(bin2rank);
+    memory->create(bin2rank,maxrank,"neigh:bin2rank");
+    rankx = ranky = rankz = 0;
+  }
+
+  if (mbinx != rankx || mbiny != ranky || mbinz != rankz) {
+    utils::morton_rank(mbinx,mbiny,mbinz,bin2rank);
+    bin2rank[mbins-1] = mbins-1;
+    rankx = mbinx;
+    ranky = mbiny;
+    rankz = mbinz;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   bin owned and ghost atoms
+   atoms are packed contiguously per bin with bins in Morton order,
+     within a bin in ascending index so ghosts follow owned atoms
+   binhead and bins are rebuilt from the packed order for other NPair styles
+------------------------------------------------------------------------- */
+
+void NBinSorted::bin_atoms()
+{
+  int i,ibin,irank,pos;
+
+  last_bin = update->ntimestep;
+
+  double **x = atom->x;
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+
+  if (includegroup) {
+    int bitmask = group->bitmask[includegroup];
+    int nfirst = atom->nfirst;
+    for (i = 0; i < nall; i++) {
+      if (i < nfirst || (i >= nlocal && (mask[i] & bitmask)))
+        atom2bin[i] = coord2bin(x[i]);
+      else atom2bin[i] = -1;
+    }
+  } else {
+    for (i = 0; i < nall; i++) atom2bin[i] = coord2bin(x[i]);
+  }
+
+  // counting sort by bin rank, binstart[irank] is the end of bin irank
+  // after the fill pass, shift right by one to get the start of each bin
+
+  for (i = 0; i <= mbins; i++) binstart[i] = 0;
+  for (i = 0; i < nall; i++)
+    if (atom2bin[i] >= 0) binstart[bin2rank[atom2bin[i]]+1]++;
+  for (i = 1; i <= mbins; i++) binstart[i] += binstart[i-1];
+
+  for (i = 0; i < nall; i++) {
+    ibin = atom2bin[i];
+    if (ibin < 0) {
+      atom2pos[i] = -1;
+      continue;
+    }
+    pos = binstart[bin2rank[ibin]]++;
+    binpack[pos] = i;
+    atom2pos[i] = pos;
+    binx[3*pos] = x[i][0];
+    binx[3*pos+1] = x[i][1];
+    binx[3*pos+2] = x[i][2];
+  }
+
+  for (i = mbins; i > 0; i--) binstart[i] = binstart[i-1];
+  binstart[0] = 0;
+
+  for (ibin = 0; ibin < mbins; ibin++) {
+    irank = bin2rank[ibin];
+    if (binstart[irank] == binstart[irank+1]) {
+      binhead[ibin] = -1;
+      continue;
+    }
+    binhead[ibin] = binpack[binstart[irank]];
+    for (pos = binstart[irank]; pos < binstart[irank+1]-1; pos++)
+      bins[binpack[pos]] = binpack[pos+1];
+    bins[binpack[pos]] = -1;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double NBinSorted::memory_usage()
+{
+  double bytes = NBinStandard::memory_usage();
+  bytes += (double)(maxrank+maxstart)*sizeof(int);
+  bytes += (double)2*maxpack*sizeof(int);
+  bytes += (double)3*maxpack*sizeof(double);
+  return bytes;
+}
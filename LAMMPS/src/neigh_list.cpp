@@ -64,6 +64,16 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
 
   ipage = nullptr;
 
+  // Verlet cluster-pair lists
+
+  cluster = 0;
+  ncluster = nicluster = 0;
+  clatom = nullptr;
+  cjfirst = nullptr;
+  cjlist = nullptr;
+  cjmask = nullptr;
+  maxcluster = maxcjpair = 0;
+
   // extra rRESPA lists
 
   inum_inner = gnum_inner = 0;
@@ -120,6 +130,11 @@ NeighList::~NeighList()
     delete [] ipage_middle;
   }
 
+  memory->destroy(clatom);
+  memory->destroy(cjfirst);
+  memory->destroy(cjlist);
+  memory->destroy(cjmask);
+
   delete [] iskip;
   memory->destroy(ijskip);
 }
@@ -141,6 +156,7 @@ void NeighList::post_constructor(NeighRequest *nq)
   occasional = nq->occasional;
   ghost = nq->ghost;
   ssa = nq->ssa;
+  cluster = nq->cluster;
   history = nq->history;
   respaouter = nq->respaouter;
   respamiddle = nq->respamiddle;
@@ -315,6 +331,12 @@ double NeighList::memory_usage()
       bytes += ipage[i].size();
   }
 
+  if (cluster) {
+    bytes += 4.0 * maxcluster * sizeof(int);
+    bytes += (double)(maxcluster+1) * sizeof(int);
+    bytes += (double)maxcjpair * (sizeof(int) + sizeof(unsigned int));
+  }
+
   if (respainner) {
     bytes += memory->usage(ilist_inner,maxatom);
     bytes += memory->usage(numneigh_inner,maxatom);
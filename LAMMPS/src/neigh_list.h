@@ -37,6 +37,7 @@ class NeighList : protected Pointers {
   int occasional;     // 0 if build every reneighbor, 1 if not
   int ghost;          // 1 if list stores neighbors of ghosts
   int ssa;            // 1 if list stores Shardlow data
+  int cluster;        // j-cluster size (4 or 8) if list stores cluster pairs, else 0
   int history;        // 1 if there is neigh history (FixNeighHist)
   int respaouter;     // 1 if list is a rRespa outer list
   int respamiddle;    // 1 if there is also a rRespa middle list
@@ -60,6 +61,20 @@ class NeighList : protected Pointers {
   int oneatom;           // max size for one atom
   MyPage<int> *ipage;    // pages of neighbor indices
 
+  // data structs to store Verlet cluster pairs, see NPairCluster
+  // clusters hold 4 atoms, a j-cluster of 8 is the pair of 4-clusters 2*cj, 2*cj+1
+  // bit ii*cluster+jj of cjmask is set if atom ii of the i-cluster
+  //   interacts with atom jj of the j-cluster
+
+  int ncluster;              // # of 4-atom clusters, owned clusters first
+  int nicluster;             // # of i-clusters = clusters of owned atoms
+  int *clatom;               // atom index of each cluster slot, -1 if padding
+  int *cjfirst;              // index in cjlist of 1st j-cluster of each i-cluster
+  int *cjlist;               // j-cluster indices
+  unsigned int *cjmask;      // atom pair mask for each j-cluster in cjlist
+  int maxcluster;            // size of allocated per-cluster arrays
+  int maxcjpair;             // size of allocated cjlist and cjmask
+
   // data structs to store rRESPA neighbor pairs I,J and associated values
 
   int inum_inner;            // # of I atoms neighbors are stored for
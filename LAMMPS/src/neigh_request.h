@@ -80,6 +80,7 @@ class NeighRequest : protected Pointers {
   int kokkos_host;     // set by KOKKOS package
   int kokkos_device;
   int ssa;          // set by DPD-REACT package, for Shardlow lists
+  int cluster;      // j-cluster size of a Verlet cluster-pair list, 0 if per-atom list
   int cut;          // 1 if use a non-standard cutoff length
   double cutoff;    // special cutoff distance for this list
 
@@ -133,6 +134,7 @@ class NeighRequest : protected Pointers {
 
   void apply_flags(int);
   void set_cutoff(double);
+  void set_cluster(int);
   void set_id(int);
   void set_kokkos_device(int);
   void set_kokkos_host(int);
@@ -48,6 +48,7 @@
 #include "style_nstencil.h"  // IWYU pragma: keep
 #include "style_ntopo.h"  // IWYU pragma: keep
 #include "suffix.h"
+#include "timer.h"
 #include "tokenizer.h"
 #include "update.h"
 
@@ -63,6 +64,11 @@ static constexpr int DELTA_PERATOM = 64;
 
 static constexpr double BIG = 1.0e20;
 
+static constexpr int AUTOSKIN_NBUILD = 5;        // triggered builds per skin adjustment
+static constexpr int AUTOSKIN_NSAMPLE = 20;      // trial skins per adjustment
+static constexpr double AUTOSKIN_STEP = 1.25;    // max factor of skin change per adjustment
+static constexpr double AUTOSKIN_GAIN = 0.02;    // min predicted relative gain to reset skin
+
 enum{NONE,ALL,PARTIAL,TEMPLATE};
 
 static const char cite_neigh_multi_old[] =
@@ -134,6 +140,11 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   pgsize = 100000;
   oneatom = 2000;
   binsizeflag = 0;
+  binsortflag = 0;
+  autoskin = 0;
+  autoskin_active = 0;
+  autoskin_first = 1;
+  autoskin_min = autoskin_max = 0.0;
   build_once = 0;
   cluster_check = 0;
   ago = -1;
@@ -174,6 +185,7 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   old_triclinic = 0;
   old_pgsize = pgsize;
   old_oneatom = oneatom;
+  old_binsortflag = binsortflag;
 
   binclass = nullptr;
   binnames = nullptr;
@@ -357,32 +369,7 @@ void Neighbor::init()
     cuttypesq = new double[n+1];
   }
 
-  double cutoff,delta,cut;
-  cutneighmin = BIG;
-  cutneighmax = 0.0;
-
-  for (i = 1; i <= n; i++) {
-    cuttype[i] = cuttypesq[i] = 0.0;
-    for (j = 1; j <= n; j++) {
-      if (force->pair) cutoff = sqrt(force->pair->cutsq[i][j]);
-      else cutoff = 0.0;
-      if (cutoff > 0.0) delta = skin;
-      else delta = 0.0;
-      cut = cutoff + delta;
-
-      cutneighsq[i][j] = cut*cut;
-      cuttype[i] = MAX(cuttype[i],cut);
-      cuttypesq[i] = MAX(cuttypesq[i],cut*cut);
-      cutneighmin = MIN(cutneighmin,cut);
-      cutneighmax = MAX(cutneighmax,cut);
-
-      if (force->pair && force->pair->ghostneigh) {
-        cut = force->pair->cutghost[i][j] + skin;
-        cutneighghostsq[i][j] = cut*cut;
-      } else cutneighghostsq[i][j] = cut*cut;
-    }
-  }
-  cutneighmaxsq = cutneighmax * cutneighmax;
+  set_cutneigh();
 
   // Define cutoffs for multi
   if (style == Neighbor::MULTI) {
@@ -677,6 +664,29 @@ void Neighbor::init()
 
   if (!same && (nrequest > 0) && (comm->me == 0)) print_pairwise_info();
 
+  // automatic skin tuning requires Verlet dynamics and lists whose
+  // cutoffs all follow the skin, so they can be reset at a rebuild
+
+  autoskin_active = 0;
+  if (autoskin && (update->whichflag == 1) && utils::strmatch(update->integrate_style,"^verlet")) {
+    std::string reason;
+    for (i = 0; i < nrequest; i++)
+      if (requests[i]->cut && !requests[i]->occasional) reason = "custom neighbor list cutoffs";
+    if (skin <= 0.0) reason = "a zero skin";
+    if (!dist_check) reason = "neigh_modify check no";
+    if (style == Neighbor::MULTI || style == Neighbor::MULTI_OLD) reason = "neighbor style multi";
+    if (lmp->kokkos) reason = "the KOKKOS package";
+    if (!timer->has_normal()) reason = "a timer level below normal";
+
+    if (reason.empty()) {
+      autoskin_active = 1;
+      autoskin_first = 1;
+      if (autoskin_min <= 0.0) autoskin_min = 0.25*skin;
+      if (autoskin_max <= 0.0) autoskin_max = 4.0*skin;
+    } else if (comm->me == 0)
+      error->warning(FLERR,"Neighbor skin auto-tuning is disabled with {}", reason);
+  }
+
   // can now delete requests so next run can make new ones
   // print_pairwise_info() made use of requests
   // set of NeighLists now stores all needed info
@@ -694,6 +704,42 @@ void Neighbor::init()
   init_topology();
 }
 
+/* ----------------------------------------------------------------------
+   set per type pair neighbor cutoffs from pair cutoffs and current skin
+------------------------------------------------------------------------- */
+
+void Neighbor::set_cutneigh()
+{
+  double cutoff,delta,cut;
+  int n = atom->ntypes;
+
+  cutneighmin = BIG;
+  cutneighmax = 0.0;
+
+  for (int i = 1; i <= n; i++) {
+    cuttype[i] = cuttypesq[i] = 0.0;
+    for (int j = 1; j <= n; j++) {
+      if (force->pair) cutoff = sqrt(force->pair->cutsq[i][j]);
+      else cutoff = 0.0;
+      if (cutoff > 0.0) delta = skin;
+      else delta = 0.0;
+      cut = cutoff + delta;
+
+      cutneighsq[i][j] = cut*cut;
+      cuttype[i] = MAX(cuttype[i],cut);
+      cuttypesq[i] = MAX(cuttypesq[i],cut*cut);
+      cutneighmin = MIN(cutneighmin,cut);
+      cutneighmax = MAX(cutneighmax,cut);
+
+      if (force->pair && force->pair->ghostneigh) {
+        cut = force->pair->cutghost[i][j] + skin;
+        cutneighghostsq[i][j] = cut*cut;
+      } else cutneighghostsq[i][j] = cut*cut;
+    }
+  }
+  cutneighmaxsq = cutneighmax * cutneighmax;
+}
+
 /* ----------------------------------------------------------------------
    create and initialize lists of Nbin, Nstencil, NPair classes
    lists have info on all classes in 3 style*.h files
@@ -801,6 +847,7 @@ int Neighbor::init_pair()
   if (triclinic != old_triclinic) same = 0;
   if (pgsize != old_pgsize) same = 0;
   if (oneatom != old_oneatom) same = 0;
+  if (binsortflag != old_binsortflag) same = 0;
 
   if (nrequest != old_nrequest) same = 0;
   else
@@ -1281,6 +1328,7 @@ void Neighbor::morph_skip()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // 2 lists are a match
 
@@ -1444,6 +1492,7 @@ void Neighbor::morph_halffull()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // skip flag must be same
       // if both are skip lists, skip info must match
@@ -1553,6 +1602,7 @@ void Neighbor::morph_copy_trim()
       if (irq->kokkos_host && !jrq->kokkos_host) continue;
       if (irq->kokkos_device && !jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // skip flag must be same
       // if both are skip lists, skip info must match
@@ -1831,6 +1881,7 @@ void Neighbor::print_pairwise_info()
     if (rq->kokkos_device) out += ", kokkos_device";
     if (rq->kokkos_host) out += ", kokkos_host";
     if (rq->ssa) out += ", ssa";
+    if (rq->cluster) out += fmt::format(", cluster 4x{}",rq->cluster);
     if (rq->cut) out += fmt::format(", cut {}",rq->cutoff);
     if (rq->off2on) out += ", off2on";
     out += "\n";
@@ -1871,6 +1922,7 @@ void Neighbor::requests_new2old()
   old_triclinic = triclinic;
   old_pgsize = pgsize;
   old_oneatom = oneatom;
+  old_binsortflag = binsortflag;
 }
 
 /* ----------------------------------------------------------------------
@@ -1933,6 +1985,10 @@ int Neighbor::choose_bin(NeighRequest *rq)
   if (style == Neighbor::NSQ) return 0;
   if (rq->skip || rq->copy || rq->halffull) return 0;
 
+  // cluster-pair lists grid the atoms themselves
+
+  if (rq->cluster) return 0;
+
   // use request settings to match exactly one NBin class mask
   // checks are bitwise using NeighConst bit masks
 
@@ -1956,6 +2012,14 @@ int Neighbor::choose_bin(NeighRequest *rq)
       if (!(mask & NB_STANDARD)) continue;
     }
 
+    // sorted bins replace standard bins for plain requests with binsort,
+    // they also provide the linked lists used by all other NPair classes
+
+    if (mask & NB_SORTED) {
+      if (!binsortflag || (style != Neighbor::BIN)) continue;
+    } else if (binsortflag && (style == Neighbor::BIN) && !rq->intel && !rq->ssa &&
+               !rq->kokkos_device && !rq->kokkos_host) continue;
+
     return i+1;
   }
 
@@ -1979,6 +2043,7 @@ int Neighbor::choose_stencil(NeighRequest *rq)
 
   if (style == Neighbor::NSQ) return 0;
   if (rq->skip || rq->copy || rq->halffull) return 0;
+  if (rq->cluster) return 0;
 
   // convert newton request to newtflag = on or off
 
@@ -2095,6 +2160,7 @@ int Neighbor::choose_pair(NeighRequest *rq)
   // checks are bitwise using NeighConst bit masks
 
   int mask;
+  int fallback = -1;
 
   for (int i = 0; i < npclass; i++) {
     mask = pairmasks[i];
@@ -2161,6 +2227,7 @@ int Neighbor::choose_pair(NeighRequest *rq)
     if (!rq->kokkos_device != !(mask & NP_KOKKOS_DEVICE)) continue;
     if (!rq->kokkos_host != !(mask & NP_KOKKOS_HOST)) continue;
     if (!rq->ssa != !(mask & NP_SSA)) continue;
+    if (!rq->cluster != !(mask & NP_CLUSTER)) continue;
 
     if (!rq->skip != !(mask & NP_SKIP)) continue;
 
@@ -2189,12 +2256,24 @@ int Neighbor::choose_pair(NeighRequest *rq)
       if (!(mask & NP_ORTHO)) continue;
     }
 
+    // with binsort prefer a class reading the packed bins
+    // fall back to the first other match, which walks the linked lists
+
+    if (mask & NP_SORTED) {
+      if (binsortflag && (style == Neighbor::BIN)) return i+1;
+      continue;
+    }
+    if (binsortflag && (style == Neighbor::BIN)) {
+      if (fallback < 0) fallback = i+1;
+      continue;
+    }
+
     return i+1;
   }
 
   // error return if matched none
 
-  return -1;
+  return fallback;
 }
 
 /* ----------------------------------------------------------------------
@@ -2313,9 +2392,17 @@ int Neighbor::decide()
 {
   if (must_check) {
     bigint n = update->ntimestep;
-    if (restart_check && n == output->next_restart) return 1;
+    int forced = 0;
+    if (restart_check && n == output->next_restart) forced = 1;
     for (auto &ifix : fixchecklist) {
-      if (n == ifix->next_reneighbor) return 1;
+      if (n == ifix->next_reneighbor) forced = 1;
+    }
+
+    // forced builds do not measure the rebuild interval of the skin
+
+    if (forced) {
+      autoskin_first = 1;
+      return 1;
     }
   }
 
@@ -2323,10 +2410,117 @@ int Neighbor::decide()
   if (ago >= delay && ago % every == 0) {
     if (build_once) return 0;
     if (dist_check == 0) return 1;
-    return check_distance();
+    if (!check_distance()) return 0;
+    if (autoskin_active) tune_skin();
+    return 1;
   } else return 0;
 }
 
+/* ----------------------------------------------------------------------
+   accumulate pair and neighbor timings since previous triggered build
+   every AUTOSKIN_NBUILD builds choose the skin that minimizes the model
+     pair time per step ~ (cutforce+skin)^3
+     neigh time per build ~ (cutforce+skin)^3
+     steps between builds ~ skin
+   the change per adjustment is limited to a factor AUTOSKIN_STEP
+     and only made if the predicted gain exceeds AUTOSKIN_GAIN
+   a sample with dangerous builds always grows the skin
+   called at a rebuild point before atoms migrate, so new cutoffs
+     and bins are in place when the lists are built
+------------------------------------------------------------------------- */
+
+void Neighbor::tune_skin()
+{
+  double wall[2],delta[2],all[2];
+  wall[0] = timer->get_wall(Timer::PAIR);
+  wall[1] = timer->get_wall(Timer::NEIGH);
+
+  // start a new sample at the first build of a run or after a timer reset
+
+  if (autoskin_first || (wall[0] < autoskin_hold[0]) || (wall[1] < autoskin_hold[1])) {
+    autoskin_hold[0] = wall[0];
+    autoskin_hold[1] = wall[1];
+    autoskin_pair = autoskin_neigh = 0.0;
+    autoskin_steps = autoskin_builds = 0;
+    autoskin_ndanger = ndanger;
+    autoskin_first = 0;
+    return;
+  }
+
+  delta[0] = wall[0] - autoskin_hold[0];
+  delta[1] = wall[1] - autoskin_hold[1];
+  autoskin_hold[0] = wall[0];
+  autoskin_hold[1] = wall[1];
+  MPI_Allreduce(delta,all,2,MPI_DOUBLE,MPI_MAX,world);
+
+  autoskin_pair += all[0];
+  autoskin_neigh += all[1];
+  autoskin_steps += ago;
+  autoskin_builds++;
+  if (autoskin_builds < AUTOSKIN_NBUILD) return;
+
+  double tpair = autoskin_pair / autoskin_steps;
+  double tneigh = autoskin_neigh / autoskin_builds;
+  double nsteps = (double) autoskin_steps / autoskin_builds;
+  bigint danger = ndanger - autoskin_ndanger;
+  autoskin_pair = autoskin_neigh = 0.0;
+  autoskin_steps = autoskin_builds = 0;
+  autoskin_ndanger = ndanger;
+
+  // dangerous builds mean the skin is too small for the build interval
+
+  if (danger > 0) {
+    if (skin < autoskin_max) reset_skin(MIN(autoskin_max,skin*AUTOSKIN_STEP));
+    return;
+  }
+
+  double cutforce = cutneighmax - skin;
+  if ((cutforce <= 0.0) || (tpair + tneigh <= 0.0)) return;
+
+  double lo = MAX(autoskin_min,skin/AUTOSKIN_STEP);
+  double hi = MIN(autoskin_max,skin*AUTOSKIN_STEP);
+  double best = skin;
+  double current = tpair + tneigh/nsteps;
+  double cost,ratio,bestcost = current;
+
+  for (int i = 0; i <= AUTOSKIN_NSAMPLE; i++) {
+    double trial = lo + (hi-lo)*i/AUTOSKIN_NSAMPLE;
+    ratio = (cutforce+trial) / (cutforce+skin);
+    ratio = ratio*ratio*ratio;
+    cost = ratio * (tpair + tneigh*skin / (nsteps*trial));
+    if (cost < bestcost) {
+      bestcost = cost;
+      best = trial;
+    }
+  }
+
+  if (bestcost < (1.0-AUTOSKIN_GAIN)*current) reset_skin(best);
+}
+
+/* ----------------------------------------------------------------------
+   change skin at a rebuild point
+   resets neighbor cutoffs, ghost cutoff and bins for the next build
+------------------------------------------------------------------------- */
+
+void Neighbor::reset_skin(double newskin)
+{
+  if (me == 0)
+    utils::logmesg(lmp,"Neighbor skin auto-tuned from {:.6g} to {:.6g} at step {}\n",
+                   skin,newskin,update->ntimestep);
+
+  skin = newskin;
+  triggersq = 0.25*skin*skin;
+  set_cutneigh();
+
+  for (int i = 0; i < nbin; i++) neigh_bin[i]->copy_neighbor_info();
+  for (int i = 0; i < nstencil; i++) neigh_stencil[i]->copy_neighbor_info();
+  for (int i = 0; i < nlist; i++)
+    if (neigh_pair[i]) neigh_pair[i]->copy_neighbor_info();
+
+  comm->setup();
+  if (style) setup_bins();
+}
+
 /* ----------------------------------------------------------------------
    if any atom moved trigger distance (half of neighbor skin) return 1
    shrink trigger distance if box size has changed
@@ -2577,8 +2771,14 @@ void Neighbor::set(int narg, char **arg)
 {
   if (narg != 2) error->all(FLERR,"Illegal neighbor command: expected 2 arguments but found {}", narg);
 
-  skin = utils::numeric(FLERR,arg[0],false,lmp);
-  if (skin < 0.0) error->all(FLERR, "Invalid neighbor argument: {}", arg[0]);
+  // auto = start from the current skin and tune it during dynamics
+
+  if (strcmp(arg[0],"auto") == 0) autoskin = 1;
+  else {
+    autoskin = 0;
+    skin = utils::numeric(FLERR,arg[0],false,lmp);
+    if (skin < 0.0) error->all(FLERR, "Invalid neighbor argument: {}", arg[0]);
+  }
 
   if (strcmp(arg[1],"nsq") == 0) style = Neighbor::NSQ;
   else if (strcmp(arg[1],"bin") == 0) style = Neighbor::BIN;
@@ -2655,6 +2855,17 @@ void Neighbor::modify_params(int narg, char **arg)
       if (binsize_user <= 0.0) binsizeflag = 0;
       else binsizeflag = 1;
       iarg += 2;
+    } else if (strcmp(arg[iarg],"binsort") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify binsort", error);
+      binsortflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"autoskin") == 0) {
+      if (iarg+3 > narg) utils::missing_cmd_args(FLERR, "neigh_modify autoskin", error);
+      autoskin_min = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      autoskin_max = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      if ((autoskin_min <= 0.0) || (autoskin_max < autoskin_min))
+        error->all(FLERR,"Invalid neigh_modify autoskin bounds: {} {}", arg[iarg+1], arg[iarg+2]);
+      iarg += 3;
     } else if (strcmp(arg[iarg],"cluster") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify cluster", error);
       cluster_check = utils::logical(FLERR,arg[iarg+1],false,lmp);
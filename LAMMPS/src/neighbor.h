@@ -49,6 +49,10 @@ class Neighbor : protected Pointers {
 
   int binsizeflag;        // user-chosen bin size
   double binsize_user;    // set externally by some accelerator pkgs
+  int binsortflag;        // 1 if atoms are packed per bin in Morton order
+
+  int autoskin;                         // 1 if skin is tuned during dynamics
+  double autoskin_min, autoskin_max;    // bounds for the tuned skin
 
   bigint ncalls;      // # of times build has been called
   bigint ndanger;     // # of dangerous builds
@@ -191,6 +195,15 @@ class Neighbor : protected Pointers {
 
   double triggersq;    // trigger = build when atom moves this dist
 
+  int autoskin_active;           // 1 if skin is tuned in this run
+  int autoskin_first;            // 1 if next triggered build starts a sample
+  double autoskin_hold[2];       // pair and neigh wall time at last triggered build
+  double autoskin_pair;          // pair wall time accumulated in current sample
+  double autoskin_neigh;         // neigh wall time accumulated in current sample
+  bigint autoskin_steps;         // steps in current sample
+  int autoskin_builds;           // triggered builds in current sample
+  bigint autoskin_ndanger;       // dangerous builds before current sample
+
   double **xhold;    // atom coords at last neighbor build
   int maxhold;       // size of xhold array
 
@@ -203,6 +216,7 @@ class Neighbor : protected Pointers {
 
   int old_style, old_triclinic;    // previous run info
   int old_pgsize, old_oneatom;     // used to avoid re-creating neigh lists
+  int old_binsortflag;
 
   int nstencil_perpetual;    // # of perpetual NeighStencil classes
   int npair_perpetual;       // #x of perpetual NeighPair classes
@@ -250,6 +264,9 @@ class Neighbor : protected Pointers {
 
   void init_styles();
   int init_pair();
+  void set_cutneigh();
+  void tune_skin();
+  void reset_skin(double);
   virtual void init_topology();
 
   void sort_requests();
@@ -289,7 +306,8 @@ namespace NeighConst {
     NB_KOKKOS_HOST = 1 << 2,
     NB_SSA = 1 << 3,
     NB_STANDARD = 1 << 4,
-    NB_MULTI = 1 << 5
+    NB_MULTI = 1 << 5,
+    NB_SORTED = 1 << 6
   };
 
   enum {
@@ -334,7 +352,9 @@ namespace NeighConst {
     NP_HALF_FULL = 1 << 23,
     NP_OFF2ON = 1 << 24,
     NP_MULTI_OLD = 1 << 25,
-    NP_TRIM = 1 << 26
+    NP_TRIM = 1 << 26,
+    NP_SORTED = 1 << 27,
+    NP_CLUSTER = 1 << 28
   };
 
   enum {
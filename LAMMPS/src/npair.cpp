@@ -141,6 +141,12 @@ void NPair::copy_bin_info()
   bins = nb->bins;
   binhead = nb->binhead;
 
+  bin2rank = nb->bin2rank;
+  binstart = nb->binstart;
+  binpack = nb->binpack;
+  atom2pos = nb->atom2pos;
+  binx = nb->binx;
+
   nbinx_multi = nb->nbinx_multi;
   nbiny_multi = nb->nbiny_multi;
   nbinz_multi = nb->nbinz_multi;
@@ -80,6 +80,8 @@ class NPair : protected Pointers {
   double bininvx, bininvy, bininvz;
   int *atom2bin, *bins;
   int *binhead;
+  int *bin2rank, *binstart, *binpack, *atom2pos;
+  double *binx;
 
   int *nbinx_multi, *nbiny_multi, *nbinz_multi;
   int *mbins_multi;
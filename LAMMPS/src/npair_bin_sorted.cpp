@@ -0,0 +1,213 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "npair_bin_sorted.h"
+
+#include "atom.h"
+#include "atom_vec.h"
+#include "domain.h"
+#include "error.h"
+#include "force.h"
+#include "molecule.h"
+#include "my_page.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+
+#include <cmath>
+
+using namespace LAMMPS_NS;
+using namespace NeighConst;
+
+/* ---------------------------------------------------------------------- */
+
+template<int HALF, int NEWTON, int TRI, int ATOMONLY>
+NPairBinSorted<HALF, NEWTON, TRI, ATOMONLY>::NPairBinSorted(LAMMPS *lmp) : NPair(lmp) {}
+
+/* ----------------------------------------------------------------------
+   same lists as NPairBin, but stencil bins are scanned as contiguous
+     ranges of the packed per-bin arrays of NBinSorted
+   atoms within a packed bin are in ascending index like the linked lists,
+     so the resulting neighbor lists are identical to NPairBin
+------------------------------------------------------------------------- */
+
+template<int HALF, int NEWTON, int TRI, int ATOMONLY>
+void NPairBinSorted<HALF, NEWTON, TRI, ATOMONLY>::build(NeighList *list)
+{
+  int i, j, k, n, p, itype, jtype, ibin, jrank, pstart, pend, which, imol, iatom, moltemplate;
+  tagint itag, jtag, tagprev;
+  double xtmp, ytmp, ztmp, delx, dely, delz, rsq;
+  const double *xj;
+  int *neighptr;
+
+  const double delta = 0.01 * force->angstrom;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  tagint *tag = atom->tag;
+  tagint *molecule = atom->molecule;
+  tagint **special = atom->special;
+  int **nspecial = atom->nspecial;
+  int nlocal = atom->nlocal;
+  if (includegroup) nlocal = atom->nfirst;
+
+  int *molindex = atom->molindex;
+  int *molatom = atom->molatom;
+  Molecule **onemols = atom->avec->onemols;
+  if (!ATOMONLY) {
+    if (molecular == Atom::TEMPLATE)
+      moltemplate = 1;
+    else
+      moltemplate = 0;
+  }
+
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  MyPage<int> *ipage = list->ipage;
+
+  int inum = 0;
+  ipage->reset();
+
+  for (i = 0; i < nlocal; i++) {
+    n = 0;
+    neighptr = ipage->vget();
+
+    itag = tag[i];
+    itype = type[i];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    if (!ATOMONLY) {
+      if (moltemplate) {
+        imol = molindex[i];
+        iatom = molatom[i];
+        tagprev = tag[i] - iatom - 1;
+      }
+    }
+
+    ibin = atom2bin[i];
+
+    for (k = 0; k < nstencil; k++) {
+      jrank = bin2rank[ibin + stencil[k]];
+      pstart = binstart[jrank];
+      pend = binstart[jrank + 1];
+      if (HALF && NEWTON && (!TRI)) {
+        if (k == 0) {
+          // Half neighbor list, newton on, orthonormal
+          // loop over rest of atoms in i's bin, ghosts are at end of packed bin
+          pstart = atom2pos[i] + 1;
+        }
+      }
+
+      for (p = pstart; p < pend; p++) {
+        j = binpack[p];
+        xj = &binx[3 * p];
+
+        if (!HALF) {
+          // Full neighbor list
+          // only skip i = j
+          if (i == j) continue;
+        } else if (!NEWTON) {
+          // Half neighbor list, newton off
+          // only store pair if i < j
+          if (j <= i) continue;
+        } else if (TRI) {
+          // for triclinic, bin stencil is full in all 3 dims
+          // must use itag/jtag to eliminate half the I/J interactions
+          if (j <= i) continue;
+          if (j >= nlocal) {
+            jtag = tag[j];
+            if (itag > jtag) {
+              if ((itag + jtag) % 2 == 0) continue;
+            } else if (itag < jtag) {
+              if ((itag + jtag) % 2 == 1) continue;
+            } else {
+              if (fabs(xj[2] - ztmp) > delta) {
+                if (xj[2] < ztmp) continue;
+              } else if (fabs(xj[1] - ytmp) > delta) {
+                if (xj[1] < ytmp) continue;
+              } else {
+                if (xj[0] < xtmp) continue;
+              }
+            }
+          }
+        } else {
+          // Half neighbor list, newton on, orthonormal
+          // in i's bin, only store ghosts "above and to the right" of i
+
+          if (k == 0) {
+            if (j >= nlocal) {
+              if (xj[2] < ztmp) continue;
+              if (xj[2] == ztmp) {
+                if (xj[1] < ytmp) continue;
+                if (xj[1] == ytmp && xj[0] < xtmp) continue;
+              }
+            }
+          }
+        }
+
+        jtype = type[j];
+        if (exclude && exclusion(i, j, itype, jtype, mask, molecule)) continue;
+
+        delx = xtmp - xj[0];
+        dely = ytmp - xj[1];
+        delz = ztmp - xj[2];
+        rsq = delx * delx + dely * dely + delz * delz;
+
+        if (ATOMONLY) {
+          if (rsq <= cutneighsq[itype][jtype]) neighptr[n++] = j;
+        } else {
+          if (rsq <= cutneighsq[itype][jtype]) {
+            if (molecular != Atom::ATOMIC) {
+              if (!moltemplate)
+                which = find_special(special[i], nspecial[i], tag[j]);
+              else if (imol >= 0)
+                which = find_special(onemols[imol]->special[iatom], onemols[imol]->nspecial[iatom],
+                                     tag[j] - tagprev);
+              else
+                which = 0;
+              if (which == 0)
+                neighptr[n++] = j;
+              else if (domain->minimum_image_check(delx, dely, delz))
+                neighptr[n++] = j;
+              else if (which > 0)
+                neighptr[n++] = j ^ (which << SBBITS);
+            } else
+              neighptr[n++] = j;
+          }
+        }
+      }
+    }
+
+    ilist[inum++] = i;
+    firstneigh[i] = neighptr;
+    numneigh[i] = n;
+    ipage->vgot(n);
+    if (ipage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+  }
+
+  list->inum = inum;
+  if (!HALF) list->gnum = 0;
+}
+
+namespace LAMMPS_NS {
+template class NPairBinSorted<0,1,0,0>;
+template class NPairBinSorted<1,0,0,0>;
+template class NPairBinSorted<1,1,0,0>;
+template class NPairBinSorted<1,1,1,0>;
+template class NPairBinSorted<0,1,0,1>;
+template class NPairBinSorted<1,0,0,1>;
+template class NPairBinSorted<1,1,0,1>;
+template class NPairBinSorted<1,1,1,1>;
+}
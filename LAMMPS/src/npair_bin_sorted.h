@@ -0,0 +1,77 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef NPAIR_CLASS
+// clang-format off
+typedef NPairBinSorted<0, 1, 0, 0> NPairFullBinSorted;
+NPairStyle(full/bin/sorted,
+           NPairFullBinSorted,
+           NP_FULL | NP_BIN | NP_MOLONLY | NP_SORTED |
+           NP_NEWTON | NP_NEWTOFF | NP_ORTHO | NP_TRI);
+
+typedef NPairBinSorted<1, 0, 0, 0> NPairHalfBinNewtoffSorted;
+NPairStyle(half/bin/newtoff/sorted,
+           NPairHalfBinNewtoffSorted,
+           NP_HALF | NP_BIN | NP_MOLONLY | NP_SORTED | NP_NEWTOFF | NP_ORTHO | NP_TRI);
+
+typedef NPairBinSorted<1, 1, 0, 0> NPairHalfBinNewtonSorted;
+NPairStyle(half/bin/newton/sorted,
+           NPairHalfBinNewtonSorted,
+           NP_HALF | NP_BIN | NP_MOLONLY | NP_SORTED | NP_NEWTON | NP_ORTHO);
+
+typedef NPairBinSorted<1, 1, 1, 0> NPairHalfBinNewtonTriSorted;
+NPairStyle(half/bin/newton/tri/sorted,
+           NPairHalfBinNewtonTriSorted,
+           NP_HALF | NP_BIN | NP_MOLONLY | NP_SORTED | NP_NEWTON | NP_TRI);
+
+typedef NPairBinSorted<0, 1, 0, 1> NPairFullBinAtomonlySorted;
+NPairStyle(full/bin/atomonly/sorted,
+           NPairFullBinAtomonlySorted,
+           NP_FULL | NP_BIN | NP_ATOMONLY | NP_SORTED |
+           NP_NEWTON | NP_NEWTOFF | NP_ORTHO | NP_TRI);
+
+typedef NPairBinSorted<1, 0, 0, 1> NPairHalfBinAtomonlyNewtoffSorted;
+NPairStyle(half/bin/atomonly/newtoff/sorted,
+           NPairHalfBinAtomonlyNewtoffSorted,
+           NP_HALF | NP_BIN | NP_ATOMONLY | NP_SORTED | NP_NEWTOFF | NP_ORTHO | NP_TRI);
+
+typedef NPairBinSorted<1, 1, 0, 1> NPairHalfBinAtomonlyNewtonSorted;
+NPairStyle(half/bin/atomonly/newton/sorted,
+           NPairHalfBinAtomonlyNewtonSorted,
+           NP_HALF | NP_BIN | NP_ATOMONLY | NP_SORTED | NP_NEWTON | NP_ORTHO);
+
+typedef NPairBinSorted<1, 1, 1, 1> NPairHalfBinAtomonlyNewtonTriSorted;
+NPairStyle(half/bin/atomonly/newton/tri/sorted,
+           NPairHalfBinAtomonlyNewtonTriSorted,
+           NP_HALF | NP_BIN | NP_ATOMONLY | NP_SORTED | NP_NEWTON | NP_TRI);
+// clang-format on
+#else
+
+#ifndef LMP_NPAIR_BIN_SORTED_H
+#define LMP_NPAIR_BIN_SORTED_H
+
+#include "npair.h"
+
+namespace LAMMPS_NS {
+
+template<int HALF, int NEWTON, int TRI, int ATOMONLY>
+class NPairBinSorted : public NPair {
+ public:
+  NPairBinSorted(class LAMMPS *);
+  void build(class NeighList *) override;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
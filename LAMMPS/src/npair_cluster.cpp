@@ -0,0 +1,340 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "npair_cluster.h"
+
+#include "atom.h"
+#include "domain.h"
+#include "error.h"
+#include "force.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace LAMMPS_NS;
+
+static constexpr int CLUSTER = 4;
+static constexpr double BIG = 1.0e20;
+
+/* ---------------------------------------------------------------------- */
+
+NPairCluster::NPairCluster(LAMMPS *lmp) : NPair(lmp)
+{
+  maxatom = maxcol = maxclus = 0;
+  atomcol = order = nullptr;
+  colstart = colclus = nullptr;
+  clcol = nullptr;
+  clbox = nullptr;
+  jzlo = jzhi = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+NPairCluster::~NPairCluster()
+{
+  memory->destroy(atomcol);
+  memory->destroy(order);
+  memory->destroy(colstart);
+  memory->destroy(colclus);
+  memory->destroy(clcol);
+  memory->destroy(clbox);
+  memory->destroy(jzlo);
+  memory->destroy(jzhi);
+}
+
+/* ----------------------------------------------------------------------
+   grow work arrays for nall atoms, ncol columns, nclus clusters
+------------------------------------------------------------------------- */
+
+void NPairCluster::grow(int nall, int ncol, int nclus)
+{
+  if (nall > maxatom) {
+    maxatom = atom->nmax;
+    memory->destroy(atomcol);
+    memory->destroy(order);
+    memory->create(atomcol, maxatom, "neigh:atomcol");
+    memory->create(order, maxatom, "neigh:order");
+  }
+  if (ncol > maxcol) {
+    maxcol = ncol;
+    memory->destroy(colstart);
+    memory->destroy(colclus);
+    memory->create(colstart, 2 * maxcol + 1, "neigh:colstart");
+    memory->create(colclus, 2 * maxcol + 1, "neigh:colclus");
+  }
+  if (nclus > maxclus) {
+    maxclus = nclus;
+    memory->destroy(clcol);
+    memory->destroy(clbox);
+    memory->destroy(jzlo);
+    memory->destroy(jzhi);
+    memory->create(clcol, maxclus, "neigh:clcol");
+    memory->create(clbox, 6 * maxclus, "neigh:clbox");
+    memory->create(jzlo, maxclus, "neigh:jzlo");
+    memory->create(jzhi, maxclus, "neigh:jzhi");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Verlet cluster-pair list with full Newton's 3rd law
+     owned and ghost atoms are gridded into xy columns of about 4 atoms
+       per cluster height, sorted by z within each column and chunked
+       into clusters of 4, owned and ghost atoms never share a cluster
+     each cluster of owned atoms (i-cluster) is paired with all j-clusters
+       of 4 or 8 atoms whose bounding boxes are within the neighbor cutoff,
+       j-clusters of a column are z-sorted, so only the z-window of the
+       i-cluster is scanned, starting from a binary search
+     the mask of a cluster pair has a bit for each atom pair in range
+       which this proc must compute:
+       owned/owned pairs in i-cluster A, j in 4-cluster B if A < B,
+         or if A == B and j comes after i in the cluster
+       owned/ghost pairs by the tag parity rule of the triclinic lists
+------------------------------------------------------------------------- */
+
+void NPairCluster::build(NeighList *list)
+{
+  int i, j, ii, jj, c, g, s, itype, jtype;
+  tagint itag, jtag;
+  double xtmp, ytmp, ztmp, delx, dely, delz, rsq;
+
+  const double delta = 0.01 * force->angstrom;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  tagint *tag = atom->tag;
+  tagint *molecule = atom->molecule;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+  const int dimension = domain->dimension;
+
+  const int jsize = list->cluster;
+  const int jstride = jsize / CLUSTER;
+
+  // extent of owned and ghost atoms
+
+  double lo[3] = {BIG, BIG, BIG};
+  double hi[3] = {-BIG, -BIG, -BIG};
+  for (i = 0; i < nall; i++) {
+    for (int k = 0; k < 3; k++) {
+      lo[k] = MIN(lo[k], x[i][k]);
+      hi[k] = MAX(hi[k], x[i][k]);
+    }
+  }
+
+  // column width so that a cluster of 4 is about as tall as it is wide
+
+  const double cutmax = neighbor->cutneighmax;
+  double ext[3];
+  for (int k = 0; k < 3; k++) ext[k] = MAX(hi[k] - lo[k], 0.01 * cutmax);
+  double width;
+  if (dimension == 3)
+    width = cbrt(CLUSTER * ext[0] * ext[1] * ext[2] / MAX(nall, 1));
+  else
+    width = sqrt(CLUSTER * ext[0] * ext[1] / MAX(nall, 1));
+
+  int ncolx = MAX(1, static_cast<int>(ext[0] / width));
+  int ncoly = MAX(1, static_cast<int>(ext[1] / width));
+  const int ncol = ncolx * ncoly;
+  const double colinvx = ncolx / ext[0];
+  const double colinvy = ncoly / ext[1];
+
+  grow(nall, ncol, 0);
+
+  // counting sort of atoms by group = column, ghost columns after owned ones
+
+  for (g = 0; g <= 2 * ncol; g++) colstart[g] = 0;
+  for (i = 0; i < nall; i++) {
+    int ix = MIN(static_cast<int>((x[i][0] - lo[0]) * colinvx), ncolx - 1);
+    int iy = MIN(static_cast<int>((x[i][1] - lo[1]) * colinvy), ncoly - 1);
+    g = iy * ncolx + ix;
+    if (i >= nlocal) g += ncol;
+    atomcol[i] = g;
+    colstart[g + 1]++;
+  }
+  for (g = 0; g < 2 * ncol; g++) colstart[g + 1] += colstart[g];
+  for (i = 0; i < nall; i++) order[colstart[atomcol[i]]++] = i;
+  for (g = 2 * ncol; g > 0; g--) colstart[g] = colstart[g - 1];
+  colstart[0] = 0;
+
+  for (g = 0; g < 2 * ncol; g++)
+    std::sort(order + colstart[g], order + colstart[g + 1], [x](int a, int b) {
+      return (x[a][2] < x[b][2]) || ((x[a][2] == x[b][2]) && (a < b));
+    });
+
+  // clusters of each group, padded to a multiple of the j-cluster size
+
+  colclus[0] = 0;
+  for (g = 0; g < 2 * ncol; g++) {
+    int nclus = (colstart[g + 1] - colstart[g] + CLUSTER - 1) / CLUSTER;
+    nclus = (nclus + jstride - 1) / jstride * jstride;
+    colclus[g + 1] = colclus[g] + nclus;
+  }
+  const int ncluster = colclus[2 * ncol];
+  const int nicluster = colclus[ncol];
+
+  grow(nall, ncol, ncluster);
+  if (ncluster > list->maxcluster) {
+    list->maxcluster = ncluster;
+    memory->destroy(list->clatom);
+    memory->destroy(list->cjfirst);
+    memory->create(list->clatom, CLUSTER * ncluster, "neighlist:clatom");
+    memory->create(list->cjfirst, ncluster + 1, "neighlist:cjfirst");
+  }
+  int *clatom = list->clatom;
+  int *cjfirst = list->cjfirst;
+
+  for (g = 0; g < 2 * ncol; g++) {
+    int n = colstart[g];
+    for (c = colclus[g]; c < colclus[g + 1]; c++) {
+      double *box = &clbox[6 * c];
+      box[0] = box[1] = box[2] = BIG;
+      box[3] = box[4] = box[5] = -BIG;
+      clcol[c] = g % ncol;
+      for (s = 0; s < CLUSTER; s++) {
+        if (n < colstart[g + 1]) {
+          i = order[n++];
+          clatom[CLUSTER * c + s] = i;
+          for (int k = 0; k < 3; k++) {
+            box[k] = MIN(box[k], x[i][k]);
+            box[k + 3] = MAX(box[k + 3], x[i][k]);
+          }
+        } else
+          clatom[CLUSTER * c + s] = -1;
+      }
+    }
+  }
+
+  // z-range of each j-cluster, padding clusters only follow atoms of their column
+  // so both bounds are ascending within a column
+
+  for (c = 0; c < ncluster; c += jstride) {
+    const int cj = c / jstride;
+    jzlo[cj] = clbox[6 * c + 2];
+    jzhi[cj] = clbox[6 * c + 5];
+    if (jstride > 1) jzhi[cj] = MAX(jzhi[cj], clbox[6 * (c + 1) + 5]);
+  }
+
+  // search j-clusters in columns within the cutoff of each i-cluster
+
+  const double cutmaxsq = cutmax * cutmax;
+  const int reachx = static_cast<int>(ceil(cutmax * colinvx));
+  const int reachy = static_cast<int>(ceil(cutmax * colinvy));
+  int npair = 0;
+
+  for (int ci = 0; ci < nicluster; ci++) {
+    cjfirst[ci] = npair;
+    if (clatom[CLUSTER * ci] < 0) continue;
+
+    const double *ibox = &clbox[6 * ci];
+    const int cx = clcol[ci] % ncolx;
+    const int cy = clcol[ci] / ncolx;
+    const double zmin = ibox[2] - cutmax;
+    const double zmax = ibox[5] + cutmax;
+
+    for (int jy = MAX(cy - reachy, 0); jy <= MIN(cy + reachy, ncoly - 1); jy++) {
+      for (int jx = MAX(cx - reachx, 0); jx <= MIN(cx + reachx, ncolx - 1); jx++) {
+        for (g = jy * ncolx + jx; g < 2 * ncol; g += ncol) {
+
+          // 1st j-cluster of the column reaching down to zmin, stop above zmax
+
+          const int cjend = colclus[g + 1] / jstride;
+          int cj = std::lower_bound(jzhi + colclus[g] / jstride, jzhi + cjend, zmin) - jzhi;
+          for (; (cj < cjend) && (jzlo[cj] <= zmax); cj++) {
+            c = cj * jstride;
+
+            // every owned pair of this j-cluster is stored with a lower i-cluster
+
+            if ((g < ncol) && (c + jstride - 1 < ci)) continue;
+
+            double dsq = 0.0;
+            for (int k = 0; k < 3; k++) {
+              double jlo = clbox[6 * c + k], jhi = clbox[6 * c + k + 3];
+              if (jstride > 1) {
+                jlo = MIN(jlo, clbox[6 * (c + 1) + k]);
+                jhi = MAX(jhi, clbox[6 * (c + 1) + k + 3]);
+              }
+              double d = MAX(jlo - ibox[k + 3], ibox[k] - jhi);
+              if (d > 0.0) dsq += d * d;
+            }
+            if (dsq > cutmaxsq) continue;
+
+            unsigned int pmask = 0;
+            for (ii = 0; ii < CLUSTER; ii++) {
+              i = clatom[CLUSTER * ci + ii];
+              if (i < 0) continue;
+              itag = tag[i];
+              itype = type[i];
+              xtmp = x[i][0];
+              ytmp = x[i][1];
+              ztmp = x[i][2];
+
+              for (jj = 0; jj < jsize; jj++) {
+                s = CLUSTER * c + jj;
+                j = clatom[s];
+                if (j < 0) continue;
+
+                if (j < nlocal) {
+                  const int cb = s / CLUSTER;
+                  if ((cb < ci) || ((cb == ci) && (s % CLUSTER <= ii))) continue;
+                } else {
+                  jtag = tag[j];
+                  if (itag > jtag) {
+                    if ((itag + jtag) % 2 == 0) continue;
+                  } else if (itag < jtag) {
+                    if ((itag + jtag) % 2 == 1) continue;
+                  } else {
+                    if (fabs(x[j][2] - ztmp) > delta) {
+                      if (x[j][2] < ztmp) continue;
+                    } else if (fabs(x[j][1] - ytmp) > delta) {
+                      if (x[j][1] < ytmp) continue;
+                    } else {
+                      if (x[j][0] < xtmp) continue;
+                    }
+                  }
+                }
+
+                jtype = type[j];
+                if (exclude && exclusion(i, j, itype, jtype, mask, molecule)) continue;
+
+                delx = xtmp - x[j][0];
+                dely = ytmp - x[j][1];
+                delz = ztmp - x[j][2];
+                rsq = delx * delx + dely * dely + delz * delz;
+                if (rsq <= cutneighsq[itype][jtype]) pmask |= 1U << (ii * jsize + jj);
+              }
+            }
+            if (!pmask) continue;
+
+            if (npair == list->maxcjpair) {
+              list->maxcjpair += MAX(list->maxcjpair / 2, ncluster);
+              memory->grow(list->cjlist, list->maxcjpair, "neighlist:cjlist");
+              memory->grow(list->cjmask, list->maxcjpair, "neighlist:cjmask");
+            }
+            list->cjlist[npair] = cj;
+            list->cjmask[npair++] = pmask;
+          }
+        }
+      }
+    }
+  }
+  cjfirst[nicluster] = npair;
+
+  list->ncluster = ncluster;
+  list->nicluster = nicluster;
+  list->inum = 0;
+  list->gnum = 0;
+}
@@ -0,0 +1,53 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef NPAIR_CLASS
+// clang-format off
+NPairStyle(half/cluster/newton,
+           NPairCluster,
+           NP_HALF | NP_CLUSTER | NP_NSQ | NP_BIN | NP_ATOMONLY |
+           NP_NEWTON | NP_ORTHO | NP_TRI);
+// clang-format on
+#else
+
+#ifndef LMP_NPAIR_CLUSTER_H
+#define LMP_NPAIR_CLUSTER_H
+
+#include "npair.h"
+
+namespace LAMMPS_NS {
+
+class NPairCluster : public NPair {
+ public:
+  NPairCluster(class LAMMPS *);
+  ~NPairCluster() override;
+  void build(class NeighList *) override;
+
+ protected:
+  int maxatom, maxcol, maxclus;
+  int *atomcol;      // xy column of each atom
+  int *order;        // atoms sorted by column, owned first, by z within column
+  int *colstart;     // 1st entry in order of each column, owned then ghost
+  int *colclus;      // 1st cluster of each column, owned then ghost
+  int *clcol;        // column of each cluster
+  double *clbox;     // bounding box of each cluster, lo then hi
+  double *jzlo;      // lowest z of each j-cluster, ascending within a column
+  double *jzhi;      // highest z of each j-cluster, ascending within a column
+
+  void grow(int, int, int);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
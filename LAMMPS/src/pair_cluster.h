@@ -0,0 +1,350 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_PAIR_CLUSTER_H
+#define LMP_PAIR_CLUSTER_H
+
+#include "atom.h"
+#include "error.h"
+#include "force.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neigh_request.h"
+#include "neighbor.h"
+
+#include <cstring>
+
+// request SIMD code generation for the j-cluster loop where supported,
+// e.g. compile with -DUSE_OMP_SIMD -fopenmp-simd
+
+#if defined(USE_OMP_SIMD)
+#define CLUSTER_SIMD _Pragma("omp simd reduction(+:fxi,fyi,fzi)")
+#else
+#define CLUSTER_SIMD
+#endif
+
+namespace LAMMPS_NS {
+
+/* ----------------------------------------------------------------------
+   Verlet cluster-pair loop shared by the lj/cut/cluster and morse/cluster styles
+   PairBase provides settings and the per type pair coefficients,
+   KERNEL is a functor with the force and energy of one pair, computed
+     from a row of KERNEL::NCOEFF coefficients with cutsq in the 1st
+   derived classes fill the coefficient row of a type pair in pack_coeff()
+------------------------------------------------------------------------- */
+
+template <class PairBase, class KERNEL> class PairCluster : public PairBase {
+ public:
+  PairCluster(class LAMMPS *);
+  ~PairCluster() override;
+  void compute(int, int) override;
+  void settings(int, char **) override;
+  void init_style() override;
+  double init_one(int, int) override;
+  double memory_usage() override;
+
+ protected:
+  using PairBase::atom;
+  using PairBase::error;
+  using PairBase::force;
+  using PairBase::list;
+  using PairBase::lmp;
+  using PairBase::memory;
+  using PairBase::neighbor;
+
+  static constexpr int CLUSTER = 4;
+
+  int jcluster;     // j-cluster size, 4 or 8
+  int maxslot;      // allocated # of cluster slots
+  double *xc;       // coordinates of each cluster slot
+  double *fc;       // forces of each cluster slot
+  int *tc;          // atom type of each cluster slot
+  int ntcoeff;      // # of atom types coeff is allocated for
+  double *coeff;    // coefficient row of each type pair, cutsq first
+  KERNEL kernel;
+
+  virtual void pack_coeff(int, int, double *) = 0;
+  template <int JSIZE, int EVFLAG, int EFLAG> void eval();
+};
+
+/* ---------------------------------------------------------------------- */
+
+template <class PairBase, class KERNEL>
+PairCluster<PairBase, KERNEL>::PairCluster(LAMMPS *lmp) : PairBase(lmp)
+{
+  this->respa_enable = 0;
+  jcluster = 4;
+  maxslot = 0;
+  xc = fc = nullptr;
+  tc = nullptr;
+  ntcoeff = 0;
+  coeff = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class PairBase, class KERNEL> PairCluster<PairBase, KERNEL>::~PairCluster()
+{
+  memory->destroy(xc);
+  memory->destroy(fc);
+  memory->destroy(tc);
+  memory->destroy(coeff);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class PairBase, class KERNEL>
+void PairCluster<PairBase, KERNEL>::compute(int eflag, int vflag)
+{
+  this->ev_init(eflag, vflag);
+
+  // gather coords and types into cluster order, padding slots get type 1
+  // coords are stored x, y, z blocks of one j-cluster each
+
+  const int nslot = CLUSTER * list->ncluster;
+  if (nslot > maxslot) {
+    maxslot = nslot;
+    memory->destroy(xc);
+    memory->destroy(fc);
+    memory->destroy(tc);
+    memory->create(xc, 3 * maxslot, "pair:xc");
+    memory->create(fc, 3 * maxslot, "pair:fc");
+    memory->create(tc, maxslot, "pair:tc");
+  }
+
+  double **x = atom->x;
+  double **f = atom->f;
+  int *type = atom->type;
+  const int *clatom = list->clatom;
+  const int jsize = list->cluster;
+
+  for (int s = 0; s < nslot; s++) {
+    const int i = clatom[s];
+    const int k = 3 * (s - s % jsize) + s % jsize;
+    if (i >= 0) {
+      xc[k] = x[i][0];
+      xc[k + jsize] = x[i][1];
+      xc[k + 2 * jsize] = x[i][2];
+      tc[s] = type[i];
+    } else {
+      xc[k] = xc[k + jsize] = xc[k + 2 * jsize] = 0.0;
+      tc[s] = 1;
+    }
+  }
+  memset(fc, 0, 3 * nslot * sizeof(double));
+
+  if (jsize == 8) {
+    if (this->evflag) {
+      if (eflag) eval<8, 1, 1>();
+      else eval<8, 1, 0>();
+    } else eval<8, 0, 0>();
+  } else {
+    if (this->evflag) {
+      if (eflag) eval<4, 1, 1>();
+      else eval<4, 1, 0>();
+    } else eval<4, 0, 0>();
+  }
+
+  for (int s = 0; s < nslot; s++) {
+    const int i = clatom[s];
+    if (i < 0) continue;
+    const int k = 3 * (s - s % jsize) + s % jsize;
+    f[i][0] += fc[k];
+    f[i][1] += fc[k + jsize];
+    f[i][2] += fc[k + 2 * jsize];
+  }
+
+  if (this->vflag_fdotr) this->virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   loop over cluster pairs, all JSIZE j-atoms of an i-atom are computed
+     and pairs outside the mask or cutoff are zeroed, so the inner loop
+     has no branches, energy and virial are tallied in a separate pass
+------------------------------------------------------------------------- */
+
+template <class PairBase, class KERNEL>
+template <int JSIZE, int EVFLAG, int EFLAG>
+void PairCluster<PairBase, KERNEL>::eval()
+{
+  constexpr int NCOEFF = KERNEL::NCOEFF;
+  double evdwl = 0.0;
+  const int nlocal = atom->nlocal;
+  const int ntypes = ntcoeff;
+  const int *clatom = list->clatom;
+  const int *cjfirst = list->cjfirst;
+  const int *cjlist = list->cjlist;
+  const unsigned int *cjmask = list->cjmask;
+
+  for (int ci = 0; ci < list->nicluster; ci++) {
+    if (clatom[CLUSTER * ci] < 0) continue;
+
+    // i-cluster is the 1st or 2nd half of a j-cluster of 8
+
+    const int ioff = 3 * (CLUSTER * ci - (CLUSTER * ci) % JSIZE) + (CLUSTER * ci) % JSIZE;
+    const double *xi = &xc[ioff];
+    const int *ti = &tc[CLUSTER * ci];
+    double fi[3 * CLUSTER] = {0.0};
+
+    for (int p = cjfirst[ci]; p < cjfirst[ci + 1]; p++) {
+      const int cj = cjlist[p];
+      const unsigned int pmask = cjmask[p];
+      const double *xj = &xc[3 * JSIZE * cj];
+      const int *tj = &tc[JSIZE * cj];
+      double *fj = &fc[3 * JSIZE * cj];
+
+      for (int ii = 0; ii < CLUSTER; ii++) {
+        const unsigned int row = pmask >> (ii * JSIZE);
+        const double xtmp = xi[ii];
+        const double ytmp = xi[JSIZE + ii];
+        const double ztmp = xi[2 * JSIZE + ii];
+        const double *coeffi = &coeff[(ti[ii] - 1) * ntypes * NCOEFF];
+
+        // coefficient rows of the j-atoms, pairs outside the mask get a zero cutoff
+
+        const double *cij[JSIZE];
+        double cutmask[JSIZE];
+        for (int jj = 0; jj < JSIZE; jj++) {
+          cij[jj] = &coeffi[(tj[jj] - 1) * NCOEFF];
+          cutmask[jj] = ((row >> jj) & 1U) ? cij[jj][0] : 0.0;
+        }
+
+        double fxi = 0.0, fyi = 0.0, fzi = 0.0;
+        CLUSTER_SIMD
+        for (int jj = 0; jj < JSIZE; jj++) {
+          const double delx = xtmp - xj[jj];
+          const double dely = ytmp - xj[JSIZE + jj];
+          const double delz = ztmp - xj[2 * JSIZE + jj];
+          const double rsq = delx * delx + dely * dely + delz * delz;
+          const bool in = rsq < cutmask[jj];
+          const double fp = in ? kernel.fpair(cij[jj], in ? rsq : 1.0) : 0.0;
+
+          fxi += delx * fp;
+          fyi += dely * fp;
+          fzi += delz * fp;
+          fj[jj] -= delx * fp;
+          fj[JSIZE + jj] -= dely * fp;
+          fj[2 * JSIZE + jj] -= delz * fp;
+        }
+
+        if (EVFLAG) {
+          for (int jj = 0; jj < JSIZE; jj++) {
+            const double delx = xtmp - xj[jj];
+            const double dely = ytmp - xj[JSIZE + jj];
+            const double delz = ztmp - xj[2 * JSIZE + jj];
+            const double rsq = delx * delx + dely * dely + delz * delz;
+            if (rsq >= cutmask[jj]) continue;
+            const double fpair = kernel.fpair(cij[jj], rsq);
+            if (EFLAG) evdwl = kernel.energy(cij[jj], rsq);
+            this->ev_tally(clatom[CLUSTER * ci + ii], clatom[JSIZE * cj + jj], nlocal, 1, evdwl,
+                           0.0, fpair, delx, dely, delz);
+          }
+        }
+
+        fi[ii] += fxi;
+        fi[CLUSTER + ii] += fyi;
+        fi[2 * CLUSTER + ii] += fzi;
+      }
+    }
+
+    double *fci = &fc[ioff];
+    for (int ii = 0; ii < CLUSTER; ii++) {
+      fci[ii] += fi[ii];
+      fci[JSIZE + ii] += fi[CLUSTER + ii];
+      fci[2 * JSIZE + ii] += fi[2 * CLUSTER + ii];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   global settings, optional jcluster keyword after the cutoff
+------------------------------------------------------------------------- */
+
+template <class PairBase, class KERNEL>
+void PairCluster<PairBase, KERNEL>::settings(int narg, char **arg)
+{
+  if (narg < 1) utils::missing_cmd_args(FLERR, std::string("pair_style ") + force->pair_style, error);
+
+  jcluster = 4;
+  int iarg = 1;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "jcluster") == 0) {
+      if (iarg + 2 > narg)
+        utils::missing_cmd_args(FLERR, fmt::format("pair_style {} jcluster", force->pair_style),
+                                error);
+      jcluster = utils::inumeric(FLERR, arg[iarg + 1], false, lmp);
+      if ((jcluster != 4) && (jcluster != 8))
+        error->all(FLERR, "Pair style {} jcluster must be 4 or 8", force->pair_style);
+      iarg += 2;
+    } else
+      error->all(FLERR, "Unknown pair_style {} keyword: {}", force->pair_style, arg[iarg]);
+  }
+
+  PairBase::settings(1, arg);
+}
+
+/* ----------------------------------------------------------------------
+   request a Verlet cluster-pair list and size the coefficient table
+------------------------------------------------------------------------- */
+
+template <class PairBase, class KERNEL> void PairCluster<PairBase, KERNEL>::init_style()
+{
+  if (atom->molecular != Atom::ATOMIC)
+    error->all(FLERR, "Pair style {} requires an atomic system", force->pair_style);
+  if (force->newton_pair == 0)
+    error->all(FLERR, "Pair style {} requires newton pair on", force->pair_style);
+  if (neighbor->includegroup)
+    error->all(FLERR, "Pair style {} does not support neigh_modify include", force->pair_style);
+
+  neighbor->add_request(this)->set_cluster(jcluster);
+
+  if (ntcoeff != atom->ntypes) {
+    ntcoeff = atom->ntypes;
+    memory->destroy(coeff);
+    memory->create(coeff, ntcoeff * ntcoeff * KERNEL::NCOEFF, "pair:coeff");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   init for one type pair i,j and corresponding j,i
+   pack the coefficient rows of both, so the kernel needs no 2d lookups
+------------------------------------------------------------------------- */
+
+template <class PairBase, class KERNEL>
+double PairCluster<PairBase, KERNEL>::init_one(int i, int j)
+{
+  const double cut = PairBase::init_one(i, j);
+
+  double *cij = &coeff[((i - 1) * ntcoeff + j - 1) * KERNEL::NCOEFF];
+  double *cji = &coeff[((j - 1) * ntcoeff + i - 1) * KERNEL::NCOEFF];
+  pack_coeff(i, j, cij);
+  pack_coeff(j, i, cji);
+  cij[0] = cji[0] = cut * cut;
+
+  return cut;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class PairBase, class KERNEL> double PairCluster<PairBase, KERNEL>::memory_usage()
+{
+  double bytes = PairBase::memory_usage();
+  bytes += (double) 6 * maxslot * sizeof(double);
+  bytes += (double) maxslot * sizeof(int);
+  bytes += (double) ntcoeff * ntcoeff * KERNEL::NCOEFF * sizeof(double);
+  return bytes;
+}
+
+}    // namespace LAMMPS_NS
+
+#endif
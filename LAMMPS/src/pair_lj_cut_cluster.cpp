@@ -0,0 +1,36 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_lj_cut_cluster.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCluster::PairLJCutCluster(LAMMPS *lmp) : PairCluster(lmp)
+{
+  cut_respa = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   coefficient row of type pair i,j for LJCutClusterKernel, cutsq is set by caller
+------------------------------------------------------------------------- */
+
+void PairLJCutCluster::pack_coeff(int i, int j, double *c)
+{
+  c[1] = lj1[i][j];
+  c[2] = lj2[i][j];
+  c[3] = lj3[i][j];
+  c[4] = lj4[i][j];
+  c[5] = offset[i][j];
+}
@@ -0,0 +1,59 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/cut/cluster,PairLJCutCluster);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_LJ_CUT_CLUSTER_H
+#define LMP_PAIR_LJ_CUT_CLUSTER_H
+
+#include "pair_cluster.h"
+#include "pair_lj_cut.h"
+
+namespace LAMMPS_NS {
+
+// coefficient row: cutsq, lj1, lj2, lj3, lj4, offset
+
+struct LJCutClusterKernel {
+  static constexpr int NCOEFF = 6;
+
+  double fpair(const double *c, double rsq) const
+  {
+    const double r2inv = 1.0 / rsq;
+    const double r6inv = r2inv * r2inv * r2inv;
+    return r6inv * (c[1] * r6inv - c[2]) * r2inv;
+  }
+
+  double energy(const double *c, double rsq) const
+  {
+    const double r2inv = 1.0 / rsq;
+    const double r6inv = r2inv * r2inv * r2inv;
+    return r6inv * (c[3] * r6inv - c[4]) - c[5];
+  }
+};
+
+class PairLJCutCluster : public PairCluster<PairLJCut, LJCutClusterKernel> {
+ public:
+  PairLJCutCluster(class LAMMPS *);
+
+ protected:
+  void pack_coeff(int, int, double *) override;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
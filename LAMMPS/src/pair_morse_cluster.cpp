@@ -0,0 +1,33 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_morse_cluster.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairMorseCluster::PairMorseCluster(LAMMPS *lmp) : PairCluster(lmp) {}
+
+/* ----------------------------------------------------------------------
+   coefficient row of type pair i,j for MorseClusterKernel, cutsq is set by caller
+------------------------------------------------------------------------- */
+
+void PairMorseCluster::pack_coeff(int i, int j, double *c)
+{
+  c[1] = alpha[i][j];
+  c[2] = r0[i][j];
+  c[3] = morse1[i][j];
+  c[4] = d0[i][j];
+  c[5] = offset[i][j];
+}
@@ -0,0 +1,61 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(morse/cluster,PairMorseCluster);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_MORSE_CLUSTER_H
+#define LMP_PAIR_MORSE_CLUSTER_H
+
+#include "pair_cluster.h"
+#include "pair_morse.h"
+
+#include <cmath>
+
+namespace LAMMPS_NS {
+
+// coefficient row: cutsq, alpha, r0, morse1, d0, offset
+
+struct MorseClusterKernel {
+  static constexpr int NCOEFF = 6;
+
+  double fpair(const double *c, double rsq) const
+  {
+    const double rinv = 1.0 / sqrt(rsq);
+    const double r = rsq * rinv;
+    const double dexp = exp(-c[1] * (r - c[2]));
+    return c[3] * (dexp * dexp - dexp) * rinv;
+  }
+
+  double energy(const double *c, double rsq) const
+  {
+    const double dexp = exp(-c[1] * (sqrt(rsq) - c[2]));
+    return c[4] * (dexp * dexp - 2.0 * dexp) - c[5];
+  }
+};
+
+class PairMorseCluster : public PairCluster<PairMorse, MorseClusterKernel> {
+ public:
+  PairMorseCluster(class LAMMPS *);
+
+ protected:
+  void pack_coeff(int, int, double *) override;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -472,6 +472,7 @@ void PairReaxFF::compute(int eflag, int vflag)
 
   Reset(api->system, api->control, api->data, api->workspace, &api->lists);
   api->workspace->realloc.num_far = write_reax_lists();
+  Set_List_Top(api->workspace->realloc.num_far, api->lists+FAR_NBRS);
 
   // forces
 
@@ -734,17 +735,12 @@ double PairReaxFF::memory_usage()
   bytes += (double)1.0 * api->system->N * sizeof(int);
   bytes += (double)1.0 * api->system->N * sizeof(double);
 
-  // From reaxff_allocate: BO
+  // From reaxff_allocate: atoms and workspace arena
   bytes += (double)1.0 * api->system->total_cap * sizeof(reax_atom);
-  bytes += (double)19.0 * api->system->total_cap * sizeof(double);
-  bytes += (double)3.0 * api->system->total_cap * sizeof(int);
+  bytes += (double)api->workspace->arena.cap;
 
-  // From reaxff_lists
-  bytes += (double)2.0 * api->lists->n * sizeof(int);
-  bytes += (double)api->lists->num_intrs * sizeof(three_body_interaction_data);
-  bytes += (double)api->lists->num_intrs * sizeof(bond_data);
-  bytes += (double)api->lists->num_intrs * sizeof(far_neighbor_data);
-  bytes += (double)api->lists->num_intrs * sizeof(hbond_data);
+  // From reaxff_lists: one arena per list
+  for (int i = 0; i < LIST_N; ++i) bytes += (double)api->lists[i].mem.cap;
 
   if (fixspecies_flag)
     bytes += (double)2 * nmax * MAXSPECBOND * sizeof(double);
@@ -752,6 +748,30 @@ double PairReaxFF::memory_usage()
   return bytes;
 }
 
+/* ----------------------------------------------------------------------
+   report at the end of a run how much of the list capacity is in use on rank 0
+------------------------------------------------------------------------- */
+
+void PairReaxFF::finish()
+{
+  if (setup_flag && (comm->me == 0)) {
+    static const char *names[LIST_N] = {"bonds", "3body", "hbonds", "far_nbrs"};
+    int nalloc = api->workspace->arena.nalloc;
+    std::string mesg = "\nReaxFF list usage on rank 0 (used/allocated entries, peak used, Mbytes):\n";
+    for (int i = 0; i < LIST_N; ++i) {
+      reax_list *l = api->lists + i;
+      if (!l->allocated) continue;
+      nalloc += l->mem.nalloc;
+      mesg += fmt::format("  {:<8} {:>10} / {:<10} {:>5.1f}%  peak {:>10} {:>10.4} Mbytes\n", names[i],
+                          l->top, l->num_intrs, (l->num_intrs > 0) ? 100.0 * l->top / l->num_intrs : 0.0,
+                          l->max_top, l->mem.cap / 1048576.0);
+    }
+    mesg += fmt::format("  workspace {} atoms {:.4} Mbytes, {} arena allocations\n",
+                        api->system->total_cap, api->workspace->arena.cap / 1048576.0, nalloc);
+    utils::logmesg(lmp, mesg);
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void PairReaxFF::FindBond()
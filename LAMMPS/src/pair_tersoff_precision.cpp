@@ -0,0 +1,632 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_tersoff_precision.h"
+
+#include "atom.h"
+#include "force.h"
+#include "math_const.h"
+#include "memory.h"
+#include "neigh_list.h"
+
+#include <cmath>
+
+using namespace LAMMPS_NS;
+using namespace MathConst;
+
+// 3-vector helpers for flt_t, MathExtra only provides double versions
+
+template <class T> static inline T dot3(const T *v1, const T *v2)
+{
+  return v1[0]*v2[0] + v1[1]*v2[1] + v1[2]*v2[2];
+}
+
+template <class T> static inline void scale3(T s, const T *v, T *ans)
+{
+  ans[0] = s*v[0];
+  ans[1] = s*v[1];
+  ans[2] = s*v[2];
+}
+
+template <class T> static inline void scaleadd3(T s, const T *v1, const T *v2, T *ans)
+{
+  ans[0] = s*v1[0] + v2[0];
+  ans[1] = s*v1[1] + v2[1];
+  ans[2] = s*v1[2] + v2[2];
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+PairTersoffPrecision<flt_t,acc_t>::PairTersoffPrecision(LAMMPS *lmp) : PairTersoff(lmp)
+{
+  fparams = nullptr;
+  nmax = 0;
+  xf = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+PairTersoffPrecision<flt_t,acc_t>::~PairTersoffPrecision()
+{
+  memory->destroy(fparams);
+  memory->destroy(xf);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairTersoffPrecision<flt_t,acc_t>::compute(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  // convert coordinates of owned and ghost atoms once per step
+
+  if (atom->nmax > nmax) {
+    memory->destroy(xf);
+    nmax = atom->nmax;
+    memory->create(xf,4*nmax,"pair:xf");
+  }
+  double **x = atom->x;
+  const int nall = atom->nlocal + atom->nghost;
+  for (int i = 0; i < nall; i++) {
+    xf[4*i] = x[i][0];
+    xf[4*i+1] = x[i][1];
+    xf[4*i+2] = x[i][2];
+    xf[4*i+3] = 0.0;
+  }
+
+  if (shift_flag) {
+    if (evflag) {
+      if (eflag) {
+        if (vflag_either) eval_flt<1,1,1,1>();
+        else eval_flt<1,1,1,0>();
+      } else {
+        if (vflag_either) eval_flt<1,1,0,1>();
+        else eval_flt<1,1,0,0>();
+      }
+    } else eval_flt<1,0,0,0>();
+
+  } else {
+
+    if (evflag) {
+      if (eflag) {
+        if (vflag_either) eval_flt<0,1,1,1>();
+        else eval_flt<0,1,1,0>();
+      } else {
+        if (vflag_either) eval_flt<0,1,0,1>();
+        else eval_flt<0,1,0,0>();
+      }
+    } else eval_flt<0,0,0,0>();
+  }
+}
+
+template <class flt_t, class acc_t>
+template <int SHIFT_FLAG, int EVFLAG, int EFLAG, int VFLAG_EITHER>
+void PairTersoffPrecision<flt_t,acc_t>::eval_flt()
+{
+  int i,j,k,ii,jj,kk,inum,jnum;
+  int itype,jtype,ktype,iparam_ij,iparam_ijk;
+  tagint itag,jtag;
+  flt_t xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
+  flt_t fforce;
+  flt_t rsq,rsq1,rsq2;
+  flt_t delr1[3],delr2[3],fi[3],fj[3],fk[3];
+  flt_t r1_hat[3],r2_hat[3];
+  flt_t zeta_ij,prefactor;
+  flt_t forceshiftfac;
+  int *ilist,*jlist,*numneigh,**firstneigh;
+
+  evdwl = 0.0;
+
+  double **x = atom->x;
+  double **f = atom->f;
+  tagint *tag = atom->tag;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  int newton_pair = force->newton_pair;
+  const flt_t cutshortsq = cutmax*cutmax;
+  const flt_t fshift = shift;
+
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  acc_t fxtmp,fytmp,fztmp;
+
+  // loop over full neighbor list of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    itag = tag[i];
+    itype = map[type[i]];
+    xtmp = xf[4*i];
+    ytmp = xf[4*i+1];
+    ztmp = xf[4*i+2];
+    fxtmp = fytmp = fztmp = 0.0;
+
+    // two-body interactions, skip half of them
+
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    int numshort = 0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+
+      delx = xtmp - xf[4*j];
+      dely = ytmp - xf[4*j+1];
+      delz = ztmp - xf[4*j+2];
+      rsq = delx*delx + dely*dely + delz*delz;
+
+      // shift rsq and store correction for force
+
+      if (SHIFT_FLAG) {
+        flt_t rsqtmp = rsq + fshift*fshift + flt_t(2.0)*std::sqrt(rsq)*fshift;
+        forceshiftfac = std::sqrt(rsqtmp/rsq);
+        rsq = rsqtmp;
+      }
+
+      if (rsq < cutshortsq) {
+        neighshort[numshort++] = j;
+        if (numshort >= maxshort) {
+          maxshort += maxshort/2;
+          memory->grow(neighshort,maxshort,"pair:neighshort");
+        }
+      }
+
+      // ties are broken with the double precision coordinates
+
+      jtag = tag[j];
+      if (itag > jtag) {
+        if ((itag+jtag) % 2 == 0) continue;
+      } else if (itag < jtag) {
+        if ((itag+jtag) % 2 == 1) continue;
+      } else {
+        if (x[j][2] < x[i][2]) continue;
+        if (x[j][2] == x[i][2] && x[j][1] < x[i][1]) continue;
+        if (x[j][2] == x[i][2] && x[j][1] == x[i][1] && x[j][0] < x[i][0]) continue;
+      }
+
+      jtype = map[type[j]];
+      iparam_ij = elem3param[itype][jtype][jtype];
+      if (rsq >= fparams[iparam_ij].cutsq) continue;
+
+      repulsive_flt(fparams[iparam_ij],rsq,fpair,EFLAG,evdwl);
+
+      // correct force for shift in rsq
+
+      if (SHIFT_FLAG) fpair *= forceshiftfac;
+
+      fxtmp += delx*fpair;
+      fytmp += dely*fpair;
+      fztmp += delz*fpair;
+      f[j][0] -= delx*fpair;
+      f[j][1] -= dely*fpair;
+      f[j][2] -= delz*fpair;
+
+      if (EVFLAG) ev_tally(i,j,nlocal,newton_pair,
+                           evdwl,0.0,fpair,delx,dely,delz);
+    }
+
+    // three-body interactions
+    // skip immediately if I-J is not within cutoff
+    acc_t fjxtmp,fjytmp,fjztmp;
+
+    for (jj = 0; jj < numshort; jj++) {
+      j = neighshort[jj];
+      jtype = map[type[j]];
+      iparam_ij = elem3param[itype][jtype][jtype];
+
+      delr1[0] = xf[4*j] - xtmp;
+      delr1[1] = xf[4*j+1] - ytmp;
+      delr1[2] = xf[4*j+2] - ztmp;
+      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
+
+      if (SHIFT_FLAG)
+        rsq1 += fshift*fshift + flt_t(2.0)*std::sqrt(rsq1)*fshift;
+
+      if (rsq1 >= fparams[iparam_ij].cutsq) continue;
+
+      const flt_t r1inv = flt_t(1.0)/std::sqrt(dot3(delr1, delr1));
+      scale3(r1inv, delr1, r1_hat);
+
+      // accumulate bondorder zeta for each i-j interaction via loop over k
+
+      fjxtmp = fjytmp = fjztmp = 0.0;
+      zeta_ij = 0.0;
+
+      for (kk = 0; kk < numshort; kk++) {
+        if (jj == kk) continue;
+        k = neighshort[kk];
+        ktype = map[type[k]];
+        iparam_ijk = elem3param[itype][jtype][ktype];
+
+        delr2[0] = xf[4*k] - xtmp;
+        delr2[1] = xf[4*k+1] - ytmp;
+        delr2[2] = xf[4*k+2] - ztmp;
+        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
+
+        if (SHIFT_FLAG)
+          rsq2 += fshift*fshift + flt_t(2.0)*std::sqrt(rsq2)*fshift;
+
+        if (rsq2 >= fparams[iparam_ijk].cutsq) continue;
+
+        flt_t r2inv = flt_t(1.0)/std::sqrt(dot3(delr2, delr2));
+        scale3(r2inv, delr2, r2_hat);
+
+        zeta_ij += zeta_flt(fparams[iparam_ijk],rsq1,rsq2,r1_hat,r2_hat);
+      }
+
+      // pairwise force due to zeta
+
+      force_zeta_flt(fparams[iparam_ij],rsq1,zeta_ij,fforce,prefactor,EFLAG,evdwl);
+
+      fpair = fforce*r1inv;
+
+      fxtmp += delr1[0]*fpair;
+      fytmp += delr1[1]*fpair;
+      fztmp += delr1[2]*fpair;
+      fjxtmp -= delr1[0]*fpair;
+      fjytmp -= delr1[1]*fpair;
+      fjztmp -= delr1[2]*fpair;
+
+      if (EVFLAG) ev_tally(i,j,nlocal,newton_pair,
+                           evdwl,0.0,-fpair,-delr1[0],-delr1[1],-delr1[2]);
+
+      // attractive term via loop over k
+
+      for (kk = 0; kk < numshort; kk++) {
+        if (jj == kk) continue;
+        k = neighshort[kk];
+        ktype = map[type[k]];
+        iparam_ijk = elem3param[itype][jtype][ktype];
+
+        delr2[0] = xf[4*k] - xtmp;
+        delr2[1] = xf[4*k+1] - ytmp;
+        delr2[2] = xf[4*k+2] - ztmp;
+        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
+
+        if (SHIFT_FLAG)
+          rsq2 += fshift*fshift + flt_t(2.0)*std::sqrt(rsq2)*fshift;
+
+        if (rsq2 >= fparams[iparam_ijk].cutsq) continue;
+
+        flt_t r2inv = flt_t(1.0)/std::sqrt(dot3(delr2, delr2));
+        scale3(r2inv, delr2, r2_hat);
+
+        attractive_flt(fparams[iparam_ijk],prefactor,
+                       rsq1,rsq2,r1_hat,r2_hat,fi,fj,fk);
+
+        fxtmp += fi[0];
+        fytmp += fi[1];
+        fztmp += fi[2];
+        fjxtmp += fj[0];
+        fjytmp += fj[1];
+        fjztmp += fj[2];
+        f[k][0] += fk[0];
+        f[k][1] += fk[1];
+        f[k][2] += fk[2];
+
+        if (VFLAG_EITHER) {
+          double fjd[3] = {fj[0],fj[1],fj[2]}, fkd[3] = {fk[0],fk[1],fk[2]};
+          double delr1d[3] = {delr1[0],delr1[1],delr1[2]};
+          double delr2d[3] = {delr2[0],delr2[1],delr2[2]};
+          v_tally3(i,j,k,fjd,fkd,delr1d,delr2d);
+        }
+      }
+      f[j][0] += fjxtmp;
+      f[j][1] += fjytmp;
+      f[j][2] += fjztmp;
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   convert parameters to flt_t after the parent has derived them
+------------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairTersoffPrecision<flt_t,acc_t>::setup_params()
+{
+  PairTersoff::setup_params();
+
+  memory->destroy(fparams);
+  memory->create(fparams,nparams,"pair:fparams");
+
+  for (int m = 0; m < nparams; m++) {
+    fparams[m].lam1 = params[m].lam1;
+    fparams[m].lam2 = params[m].lam2;
+    fparams[m].lam3 = params[m].lam3;
+    fparams[m].csq = params[m].c*params[m].c;
+    fparams[m].dsq = params[m].d*params[m].d;
+    fparams[m].h = params[m].h;
+    fparams[m].gamma = params[m].gamma;
+    fparams[m].powern = params[m].powern;
+    fparams[m].beta = params[m].beta;
+    fparams[m].biga = params[m].biga;
+    fparams[m].bigb = params[m].bigb;
+    fparams[m].bigd = params[m].bigd;
+    fparams[m].bigr = params[m].bigr;
+    fparams[m].cutsq = params[m].cutsq;
+    fparams[m].c1 = params[m].c1;
+    fparams[m].c2 = params[m].c2;
+    fparams[m].c3 = params[m].c3;
+    fparams[m].c4 = params[m].c4;
+    fparams[m].powermint = params[m].powermint;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairTersoffPrecision<flt_t,acc_t>::repulsive_flt(const ParamT &param, flt_t rsq,
+                                                      flt_t &fforce, int eflag, flt_t &eng)
+{
+  flt_t r,tmp_fc,tmp_fc_d,tmp_exp;
+
+  r = std::sqrt(rsq);
+  tmp_fc = ters_fc_flt(r,param);
+  tmp_fc_d = ters_fc_d_flt(r,param);
+  tmp_exp = std::exp(-param.lam1 * r);
+  fforce = -param.biga * tmp_exp * (tmp_fc_d - tmp_fc*param.lam1) / r;
+  if (eflag) eng = tmp_fc * param.biga * tmp_exp;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+flt_t PairTersoffPrecision<flt_t,acc_t>::zeta_flt(const ParamT &param, flt_t rsqij,
+                                                  flt_t rsqik, flt_t *rij_hat, flt_t *rik_hat)
+{
+  flt_t rij,rik,costheta,arg,ex_delr;
+
+  rij = std::sqrt(rsqij);
+  rik = std::sqrt(rsqik);
+  costheta = dot3(rij_hat,rik_hat);
+
+  arg = param.lam3 * (rij-rik);
+  if (param.powermint == 3) arg = arg*arg*arg;
+
+  if (arg > flt_t(69.0776)) ex_delr = 1.e30;
+  else if (arg < flt_t(-69.0776)) ex_delr = 0.0;
+  else ex_delr = std::exp(arg);
+
+  return ters_fc_flt(rik,param) * ters_gijk_flt(costheta,param) * ex_delr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairTersoffPrecision<flt_t,acc_t>::force_zeta_flt(const ParamT &param, flt_t rsq,
+                                                       flt_t zeta_ij, flt_t &fforce,
+                                                       flt_t &prefactor, int eflag, flt_t &eng)
+{
+  flt_t r,fa,fa_d,bij;
+
+  r = std::sqrt(rsq);
+  fa = ters_fa_flt(r,param);
+  fa_d = ters_fa_d_flt(r,param);
+  bij = ters_bij_flt(zeta_ij,param);
+  fforce = flt_t(0.5)*bij*fa_d;
+  prefactor = flt_t(-0.5)*fa * ters_bij_d_flt(zeta_ij,param);
+  if (eflag) eng = flt_t(0.5)*bij*fa;
+}
+
+/* ----------------------------------------------------------------------
+   attractive term
+   use param_ij cutoff for rij test
+   use param_ijk cutoff for rik test
+------------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairTersoffPrecision<flt_t,acc_t>::attractive_flt(const ParamT &param, flt_t prefactor,
+                                                       flt_t rsqij, flt_t rsqik,
+                                                       flt_t *rij_hat, flt_t *rik_hat,
+                                                       flt_t *fi, flt_t *fj, flt_t *fk)
+{
+  flt_t rij,rijinv,rik,rikinv;
+
+  rij = std::sqrt(rsqij);
+  rik = std::sqrt(rsqik);
+
+  // correct 1/r for shift in rsq
+
+  if (shift_flag == 1) {
+    rijinv = flt_t(1.0)/(rij - flt_t(shift));
+    rikinv = flt_t(1.0)/(rik - flt_t(shift));
+  } else {
+    rijinv = flt_t(1.0)/rij;
+    rikinv = flt_t(1.0)/rik;
+  }
+
+  ters_zetaterm_d_flt(prefactor,rij_hat,rij,rijinv,rik_hat,rik,rikinv,fi,fj,fk,param);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+flt_t PairTersoffPrecision<flt_t,acc_t>::ters_fc_flt(flt_t r, const ParamT &param)
+{
+  flt_t ters_R = param.bigr;
+  flt_t ters_D = param.bigd;
+
+  if (r < ters_R-ters_D) return 1.0;
+  if (r > ters_R+ters_D) return 0.0;
+  return flt_t(0.5)*(flt_t(1.0) - std::sin(flt_t(MY_PI2)*(r - ters_R)/ters_D));
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+flt_t PairTersoffPrecision<flt_t,acc_t>::ters_fc_d_flt(flt_t r, const ParamT &param)
+{
+  flt_t ters_R = param.bigr;
+  flt_t ters_D = param.bigd;
+
+  if (r < ters_R-ters_D) return 0.0;
+  if (r > ters_R+ters_D) return 0.0;
+  return -(flt_t(MY_PI4)/ters_D) * std::cos(flt_t(MY_PI2)*(r - ters_R)/ters_D);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+flt_t PairTersoffPrecision<flt_t,acc_t>::ters_fa_flt(flt_t r, const ParamT &param)
+{
+  if (r > param.bigr + param.bigd) return 0.0;
+  return -param.bigb * std::exp(-param.lam2 * r) * ters_fc_flt(r,param);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+flt_t PairTersoffPrecision<flt_t,acc_t>::ters_fa_d_flt(flt_t r, const ParamT &param)
+{
+  if (r > param.bigr + param.bigd) return 0.0;
+  return param.bigb * std::exp(-param.lam2 * r) *
+    (param.lam2 * ters_fc_flt(r,param) - ters_fc_d_flt(r,param));
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+flt_t PairTersoffPrecision<flt_t,acc_t>::ters_bij_flt(flt_t zeta, const ParamT &param)
+{
+  flt_t tmp = param.beta * zeta;
+  if (tmp > param.c1) return flt_t(1.0)/std::sqrt(tmp);
+  if (tmp > param.c2)
+    return (flt_t(1.0) - std::pow(tmp,-param.powern) / (flt_t(2.0)*param.powern))/std::sqrt(tmp);
+  if (tmp < param.c4) return 1.0;
+  if (tmp < param.c3)
+    return flt_t(1.0) - std::pow(tmp,param.powern)/(flt_t(2.0)*param.powern);
+  return std::pow(flt_t(1.0) + std::pow(tmp,param.powern), flt_t(-1.0)/(flt_t(2.0)*param.powern));
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+flt_t PairTersoffPrecision<flt_t,acc_t>::ters_bij_d_flt(flt_t zeta, const ParamT &param)
+{
+  flt_t tmp = param.beta * zeta;
+  if (tmp > param.c1) return param.beta * flt_t(-0.5)*std::pow(tmp,flt_t(-1.5));
+  if (tmp > param.c2)
+    return param.beta * (flt_t(-0.5)*std::pow(tmp,flt_t(-1.5)) *
+                         (flt_t(1.0) - (flt_t(1.0) + flt_t(1.0)/(flt_t(2.0)*param.powern)) *
+                          std::pow(tmp,-param.powern)));
+  if (tmp < param.c4) return 0.0;
+  if (tmp < param.c3)
+    return flt_t(-0.5)*param.beta * std::pow(tmp,param.powern-flt_t(1.0));
+
+  flt_t tmp_n = std::pow(tmp,param.powern);
+  return flt_t(-0.5) * std::pow(flt_t(1.0)+tmp_n, flt_t(-1.0)-(flt_t(1.0)/(flt_t(2.0)*param.powern)))
+    * tmp_n / zeta;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairTersoffPrecision<flt_t,acc_t>::ters_zetaterm_d_flt(flt_t prefactor,
+                                                            flt_t *rij_hat, flt_t rij,
+                                                            flt_t rijinv, flt_t *rik_hat,
+                                                            flt_t rik, flt_t rikinv,
+                                                            flt_t *dri, flt_t *drj, flt_t *drk,
+                                                            const ParamT &param)
+{
+  flt_t gijk,gijk_d,ex_delr,ex_delr_d,fc,dfc,cos_theta,tmp;
+  flt_t dcosdri[3],dcosdrj[3],dcosdrk[3];
+
+  fc = ters_fc_flt(rik,param);
+  dfc = ters_fc_d_flt(rik,param);
+  tmp = param.lam3 * (rij-rik);
+  if (param.powermint == 3) tmp = tmp*tmp*tmp;
+
+  if (tmp > flt_t(69.0776)) ex_delr = 1.e30;
+  else if (tmp < flt_t(-69.0776)) ex_delr = 0.0;
+  else ex_delr = std::exp(tmp);
+
+  if (param.powermint == 3)
+    ex_delr_d = flt_t(3.0)*param.lam3*param.lam3*param.lam3 * (rij-rik)*(rij-rik)*ex_delr;
+  else ex_delr_d = param.lam3 * ex_delr;
+
+  cos_theta = dot3(rij_hat,rik_hat);
+  gijk = ters_gijk_flt(cos_theta,param);
+  gijk_d = ters_gijk_d_flt(cos_theta,param);
+
+  // derivatives of cos(theta) wrt Ri, Rj, Rk
+
+  scaleadd3(-cos_theta,rij_hat,rik_hat,dcosdrj);
+  scale3(rijinv,dcosdrj,dcosdrj);
+  scaleadd3(-cos_theta,rik_hat,rij_hat,dcosdrk);
+  scale3(rikinv,dcosdrk,dcosdrk);
+  dcosdri[0] = -(dcosdrj[0] + dcosdrk[0]);
+  dcosdri[1] = -(dcosdrj[1] + dcosdrk[1]);
+  dcosdri[2] = -(dcosdrj[2] + dcosdrk[2]);
+
+  // compute the derivative wrt Ri
+  // dri = -dfc*gijk*ex_delr*rik_hat;
+  // dri += fc*gijk_d*ex_delr*dcosdri;
+  // dri += fc*gijk*ex_delr_d*(rik_hat - rij_hat);
+
+  scale3(-dfc*gijk*ex_delr,rik_hat,dri);
+  scaleadd3(fc*gijk_d*ex_delr,dcosdri,dri,dri);
+  scaleadd3(fc*gijk*ex_delr_d,rik_hat,dri,dri);
+  scaleadd3(-fc*gijk*ex_delr_d,rij_hat,dri,dri);
+  scale3(prefactor,dri,dri);
+
+  // compute the derivative wrt Rj
+  // drj = fc*gijk_d*ex_delr*dcosdrj;
+  // drj += fc*gijk*ex_delr_d*rij_hat;
+
+  scale3(fc*gijk_d*ex_delr,dcosdrj,drj);
+  scaleadd3(fc*gijk*ex_delr_d,rij_hat,drj,drj);
+  scale3(prefactor,drj,drj);
+
+  // compute the derivative wrt Rk
+  // drk = dfc*gijk*ex_delr*rik_hat;
+  // drk += fc*gijk_d*ex_delr*dcosdrk;
+  // drk += -fc*gijk*ex_delr_d*rik_hat;
+
+  scale3(dfc*gijk*ex_delr,rik_hat,drk);
+  scaleadd3(fc*gijk_d*ex_delr,dcosdrk,drk,drk);
+  scaleadd3(-fc*gijk*ex_delr_d,rik_hat,drk,drk);
+  scale3(prefactor,drk,drk);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+double PairTersoffPrecision<flt_t,acc_t>::memory_usage()
+{
+  double bytes = Pair::memory_usage();
+  bytes += (double)maxshort*sizeof(int);
+  bytes += (double)4*nmax*sizeof(flt_t);
+  bytes += (double)nparams*sizeof(ParamT);
+  return bytes;
+}
+
+/* ---------------------------------------------------------------------- */
+
+namespace LAMMPS_NS {
+template class PairTersoffPrecision<float,double>;
+template class PairTersoffPrecision<float,float>;
+}
@@ -0,0 +1,94 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(tersoff/mixed,PairTersoffMixed);
+PairStyle(tersoff/single,PairTersoffSingle);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_TERSOFF_PRECISION_H
+#define LMP_PAIR_TERSOFF_PRECISION_H
+
+#include "pair_tersoff.h"
+
+namespace LAMMPS_NS {
+
+// flt_t is used for coordinates, distances and the potential kernels,
+// acc_t for per-atom force accumulation and energy tally
+
+template <class flt_t, class acc_t> class PairTersoffPrecision : public PairTersoff {
+ public:
+  PairTersoffPrecision(class LAMMPS *);
+  ~PairTersoffPrecision() override;
+  void compute(int, int) override;
+  double memory_usage() override;
+
+  struct ParamT {
+    flt_t lam1, lam2, lam3;
+    flt_t csq, dsq, h;
+    flt_t gamma, powern, beta;
+    flt_t biga, bigb, bigd, bigr;
+    flt_t cutsq;
+    flt_t c1, c2, c3, c4;
+    int powermint;
+  };
+
+ protected:
+  ParamT *fparams;    // parameters converted to flt_t
+  int nmax;           // allocated size of xf
+  flt_t *xf;          // coordinates of owned and ghost atoms, padded to 4
+
+  void setup_params() override;
+
+  template <int SHIFT_FLAG, int EVFLAG, int EFLAG, int VFLAG_EITHER> void eval_flt();
+
+  void repulsive_flt(const ParamT &, flt_t, flt_t &, int, flt_t &);
+  flt_t zeta_flt(const ParamT &, flt_t, flt_t, flt_t *, flt_t *);
+  void force_zeta_flt(const ParamT &, flt_t, flt_t, flt_t &, flt_t &, int, flt_t &);
+  void attractive_flt(const ParamT &, flt_t, flt_t, flt_t, flt_t *, flt_t *, flt_t *, flt_t *,
+                      flt_t *);
+
+  flt_t ters_fc_flt(flt_t, const ParamT &);
+  flt_t ters_fc_d_flt(flt_t, const ParamT &);
+  flt_t ters_fa_flt(flt_t, const ParamT &);
+  flt_t ters_fa_d_flt(flt_t, const ParamT &);
+  flt_t ters_bij_flt(flt_t, const ParamT &);
+  flt_t ters_bij_d_flt(flt_t, const ParamT &);
+  void ters_zetaterm_d_flt(flt_t, flt_t *, flt_t, flt_t, flt_t *, flt_t, flt_t, flt_t *, flt_t *,
+                           flt_t *, const ParamT &);
+
+  inline flt_t ters_gijk_flt(const flt_t costheta, const ParamT &param) const
+  {
+    const flt_t hcth = param.h - costheta;
+    return param.gamma *
+        (flt_t(1.0) + param.csq / param.dsq - param.csq / (param.dsq + hcth * hcth));
+  }
+
+  inline flt_t ters_gijk_d_flt(const flt_t costheta, const ParamT &param) const
+  {
+    const flt_t hcth = param.h - costheta;
+    const flt_t numerator = flt_t(-2.0) * param.csq * hcth;
+    const flt_t denominator = flt_t(1.0) / (param.dsq + hcth * hcth);
+    return param.gamma * numerator * denominator * denominator;
+  }
+};
+
+typedef PairTersoffPrecision<float, double> PairTersoffMixed;
+typedef PairTersoffPrecision<float, float> PairTersoffSingle;
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -33,6 +33,7 @@ class PairVashishta : public Pair {
   void coeff(int, char **) override;
   double init_one(int, int) override;
   void init_style() override;
+  void init_list(int, class NeighList *) override;
 
   static constexpr int NPARAMS_PER_LINE = 17;
 
@@ -54,9 +55,14 @@ class PairVashishta : public Pair {
   int maxshort;       // size of short neighbor list array
   int *neighshort;    // short neighbor list array
 
+  int shortlist_flag;            // 1 if two-body and three-body terms use separate lists
+  int shortlist_support;         // 1 if compute() handles shortlist_flag
+  class NeighList *listshort;    // full neighbor list with three-body cutoff
+
   void allocate();
   void read_file(char *);
   virtual void setup_params();
+  void compute_shortlist(int, int);
   void twobody(Param *, double, double &, int, double &);
   void threebody(Param *, Param *, Param *, double, double, double *, double *, double *, double *,
                  int, double &);
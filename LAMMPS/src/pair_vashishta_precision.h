@@ -0,0 +1,62 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(vashishta/mixed,PairVashishtaMixed);
+PairStyle(vashishta/single,PairVashishtaSingle);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_VASHISHTA_PRECISION_H
+#define LMP_PAIR_VASHISHTA_PRECISION_H
+
+#include "pair_vashishta.h"
+
+namespace LAMMPS_NS {
+
+// flt_t is used for coordinates, distances and the potential kernels,
+// acc_t for per-atom force accumulation and energy tally
+
+template <class flt_t, class acc_t> class PairVashishtaPrecision : public PairVashishta {
+ public:
+  PairVashishtaPrecision(class LAMMPS *);
+  ~PairVashishtaPrecision() override;
+  void compute(int, int) override;
+  double memory_usage() override;
+
+  struct ParamT {
+    flt_t bigb, gamma, r0, bigc, costheta, big2b;
+    flt_t bigh, eta, lam1inv, lam4inv, zizj, mbigd;
+    flt_t bigw, heta, big6w, dvrc, c0;
+    flt_t cutsq2, cutsq;
+  };
+
+ protected:
+  ParamT *fparams;    // parameters converted to flt_t
+  int nmax;           // allocated size of xf
+  flt_t *xf;          // coordinates of owned and ghost atoms, padded to 4
+
+  void setup_params() override;
+  void twobody_flt(const ParamT &, flt_t, flt_t &, int, flt_t &);
+  void threebody_flt(const ParamT &, const ParamT &, const ParamT &, flt_t, flt_t, flt_t *,
+                     flt_t *, flt_t *, flt_t *, int, flt_t &);
+};
+
+typedef PairVashishtaPrecision<float, double> PairVashishtaMixed;
+typedef PairVashishtaPrecision<float, float> PairVashishtaSingle;
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -19,19 +19,29 @@
 #include "pair_vashishta_table.h"
 
 #include "atom.h"
+#include "comm.h"
 #include "error.h"
 #include "force.h"
 #include "memory.h"
 #include "neigh_list.h"
 
+#include <cmath>
+#include <cstring>
+
 using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
 PairVashishtaTable::PairVashishtaTable(LAMMPS *lmp) : PairVashishta(lmp)
 {
+  shortlist_support = 0;
   forceTable = nullptr;
   potentialTable = nullptr;
+  ntable3 = 0;
+  deltaR3 = nullptr;
+  oneOverDeltaR3 = nullptr;
+  expTable = nullptr;
+  dexpTable = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -42,6 +52,10 @@ PairVashishtaTable::~PairVashishtaTable()
 {
   memory->destroy(forceTable);
   memory->destroy(potentialTable);
+  memory->destroy(deltaR3);
+  memory->destroy(oneOverDeltaR3);
+  memory->destroy(expTable);
+  memory->destroy(dexpTable);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -163,8 +177,12 @@ void PairVashishtaTable::compute(int eflag, int vflag)
         rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
         if (rsq2 >= params[ikparam].cutsq2) continue;
 
-        threebody(&params[ijparam],&params[ikparam],&params[ijkparam],
-                  rsq1,rsq2,delr1,delr2,fj,fk,eflag,evdwl);
+        if (ntable3)
+          threebody_table(params[ijparam],params[ikparam],params[ijkparam],
+                          rsq1,rsq2,delr1,delr2,fj,fk,eflag,evdwl);
+        else
+          threebody(&params[ijparam],&params[ikparam],&params[ijkparam],
+                    rsq1,rsq2,delr1,delr2,fj,fk,eflag,evdwl);
 
         fxtmp -= fj[0] + fk[0];
         fytmp -= fj[1] + fk[1];
@@ -222,19 +240,100 @@ void PairVashishtaTable::twobody_table(const Param &param, double rsq,
   }
 }
 
+/* ----------------------------------------------------------------------
+   three-body term with the radial factors exp(gamma/(r-r0)) and
+   their derivatives linearly interpolated in r, angular part is analytic
+------------------------------------------------------------------------- */
+
+void PairVashishtaTable::threebody_table(const Param &paramij, const Param &paramik,
+                                         const Param &paramijk,
+                                         double rsq1, double rsq2,
+                                         double *delr1, double *delr2,
+                                         double *fj, double *fk, int eflag, double &eng)
+{
+  double r1,rinvsq1,fraction1,exp1,dexp1;
+  double r2,rinvsq2,fraction2,exp2,dexp2;
+  double rinv12,cs,delcs,delcssq,facexp,facrad,frad1,frad2,pcsinv,pcsinvsq,pcs;
+  double facang,facang12,csfacang,csfac1,csfac2;
+  int tableIndex;
+
+  r1 = sqrt(rsq1);
+  rinvsq1 = 1.0/rsq1;
+  fraction1 = r1*oneOverDeltaR3[paramij.ielement][paramij.jelement];
+  tableIndex = fraction1;
+  fraction1 -= tableIndex;
+  const double *etab1 = expTable[paramij.ielement][paramij.jelement] + tableIndex;
+  const double *dtab1 = dexpTable[paramij.ielement][paramij.jelement] + tableIndex;
+  exp1 = (1.0 - fraction1)*etab1[0] + fraction1*etab1[1];
+  dexp1 = (1.0 - fraction1)*dtab1[0] + fraction1*dtab1[1];
+
+  r2 = sqrt(rsq2);
+  rinvsq2 = 1.0/rsq2;
+  fraction2 = r2*oneOverDeltaR3[paramik.ielement][paramik.jelement];
+  tableIndex = fraction2;
+  fraction2 -= tableIndex;
+  const double *etab2 = expTable[paramik.ielement][paramik.jelement] + tableIndex;
+  const double *dtab2 = dexpTable[paramik.ielement][paramik.jelement] + tableIndex;
+  exp2 = (1.0 - fraction2)*etab2[0] + fraction2*etab2[1];
+  dexp2 = (1.0 - fraction2)*dtab2[0] + fraction2*dtab2[1];
+
+  rinv12 = 1.0/(r1*r2);
+  cs = (delr1[0]*delr2[0] + delr1[1]*delr2[1] + delr1[2]*delr2[2]) * rinv12;
+  delcs = cs - paramijk.costheta;
+  delcssq = delcs*delcs;
+  pcsinv = paramijk.bigc*delcssq + 1.0;
+  pcsinvsq = pcsinv*pcsinv;
+  pcs = delcssq/pcsinv;
+
+  facexp = exp1*exp2;
+
+  facrad = paramijk.bigb * facexp * pcs;
+  frad1 = paramijk.bigb * pcs * dexp1*exp2 / r1;
+  frad2 = paramijk.bigb * pcs * exp1*dexp2 / r2;
+  facang = paramijk.big2b * facexp * delcs/pcsinvsq;
+  facang12 = rinv12*facang;
+  csfacang = cs*facang;
+  csfac1 = rinvsq1*csfacang;
+
+  fj[0] = delr1[0]*(frad1+csfac1)-delr2[0]*facang12;
+  fj[1] = delr1[1]*(frad1+csfac1)-delr2[1]*facang12;
+  fj[2] = delr1[2]*(frad1+csfac1)-delr2[2]*facang12;
+
+  csfac2 = rinvsq2*csfacang;
+
+  fk[0] = delr2[0]*(frad2+csfac2)-delr1[0]*facang12;
+  fk[1] = delr2[1]*(frad2+csfac2)-delr1[1]*facang12;
+  fk[2] = delr2[2]*(frad2+csfac2)-delr1[2]*facang12;
+
+  if (eflag) eng = facrad;
+}
+
 /* ----------------------------------------------------------------------
    global settings
 ------------------------------------------------------------------------- */
 
 void PairVashishtaTable::settings(int narg, char **arg)
 {
-  if (narg != 2) error->all(FLERR,"Illegal pair_style command");
+  if (narg < 2) error->all(FLERR,"Illegal pair_style command");
 
   ntable = utils::inumeric(FLERR,arg[0],false,lmp);
   tabinner = utils::numeric(FLERR,arg[1],false,lmp);
 
   if (tabinner <= 0.0)
     error->all(FLERR,"Illegal inner cutoff for tabulation");
+
+  ntable3 = 0;
+
+  int iarg = 2;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"threebody") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"pair_style vashishta/table threebody",error);
+      ntable3 = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (ntable3 < 2)
+        error->all(FLERR,"Illegal number of three-body table points {}",ntable3);
+      iarg += 2;
+    } else error->all(FLERR,"Unknown pair_style vashishta/table keyword: {}",arg[iarg]);
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -244,6 +343,7 @@ void PairVashishtaTable::setup_params()
   PairVashishta::setup_params();
 
   create_tables();
+  if (ntable3) create_threebody_tables();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -283,11 +383,86 @@ void PairVashishtaTable::create_tables()
   }
 }
 
+/* ----------------------------------------------------------------------
+   tabulate exp(gamma/(r-r0)) and exp(gamma/(r-r0))*gamma/(r-r0)^2
+   on [0,r0] for each element pair, both go smoothly to zero at r0.
+   the maximum interpolation error at interval midpoints is reported
+   relative to the largest tabulated value
+------------------------------------------------------------------------- */
+
+void PairVashishtaTable::create_threebody_tables()
+{
+  memory->destroy(deltaR3);
+  memory->destroy(oneOverDeltaR3);
+  memory->destroy(expTable);
+  memory->destroy(dexpTable);
+
+  memory->create(deltaR3,nelements,nelements,"pair:vashishta:deltaR3");
+  memory->create(oneOverDeltaR3,nelements,nelements,"pair:vashishta:oneOverDeltaR3");
+  memory->create(expTable,nelements,nelements,ntable3+1,"pair:vashishta:expTable");
+  memory->create(dexpTable,nelements,nelements,ntable3+1,"pair:vashishta:dexpTable");
+
+  // analytic radial factor and derivative at r, zero at and beyond r0
+
+  auto radial = [](const Param &param, double r, double &e, double &de) {
+    if (r >= param.r0) {
+      e = de = 0.0;
+      return;
+    }
+    double rainv = 1.0/(r - param.r0);
+    double gsrainv = param.gamma*rainv;
+    e = exp(gsrainv);
+    de = e*gsrainv*rainv;
+  };
+
+  int i,j,idx;
+  double r,e,de;
+
+  for (i = 0; i < nelements; i++) {
+    for (j = 0; j < nelements; j++) {
+      const Param &param = params[elem3param[i][j][j]];
+      double *etab = expTable[i][j];
+      double *dtab = dexpTable[i][j];
+
+      if (param.r0 <= 0.0) {
+        deltaR3[i][j] = 0.0;
+        oneOverDeltaR3[i][j] = 0.0;
+        for (idx = 0; idx <= ntable3; idx++) etab[idx] = dtab[idx] = 0.0;
+        continue;
+      }
+
+      deltaR3[i][j] = param.r0 / (ntable3-1);
+      oneOverDeltaR3[i][j] = 1.0/deltaR3[i][j];
+      for (idx = 0; idx <= ntable3; idx++)
+        radial(param,idx*deltaR3[i][j],etab[idx],dtab[idx]);
+
+      if (comm->me == 0) {
+        double emax = 0.0, demax = 0.0, eerr = 0.0, deerr = 0.0;
+        for (idx = 0; idx < ntable3-1; idx++) {
+          emax = MAX(emax,fabs(etab[idx]));
+          demax = MAX(demax,fabs(dtab[idx]));
+          r = (idx+0.5)*deltaR3[i][j];
+          radial(param,r,e,de);
+          eerr = MAX(eerr,fabs(0.5*(etab[idx]+etab[idx+1]) - e));
+          deerr = MAX(deerr,fabs(0.5*(dtab[idx]+dtab[idx+1]) - de));
+        }
+        if (emax > 0.0) eerr /= emax;
+        if (demax > 0.0) deerr /= demax;
+        utils::logmesg(lmp,"Vashishta three-body table {}-{}: {} points, dr = {:.6g}, "
+                       "max relative error {:.3e} in exp(gamma/(r-r0)), {:.3e} in derivative\n",
+                       elements[i],elements[j],ntable3,deltaR3[i][j],eerr,deerr);
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    memory usage of tabulation arrays
 ------------------------------------------------------------------------- */
 
 double PairVashishtaTable::memory_usage()
 {
-  return (double)2*nelements*nelements*sizeof(double)*ntable;
+  double bytes = (double)2*nelements*nelements*sizeof(double)*ntable;
+  if (ntable3) bytes += (double)2*nelements*nelements*sizeof(double)*(ntable3+1);
+  return bytes;
 }
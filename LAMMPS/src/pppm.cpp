@@ -45,11 +45,21 @@ using namespace MathSpecial;
 
 static constexpr int MAXORDER = 7;
 static constexpr int OFFSET = 16384;
+static constexpr int TILE_SHIFT = 2;    // sort atoms by tiles of 4x4x4 grid points
 static constexpr double LARGE = 10000.0;
 static constexpr double SMALL = 0.00001;
 static constexpr double EPS_HOC = 1.0e-7;
 static constexpr FFT_SCALAR ZEROF = 0.0;
 
+// request SIMD code generation for the stencil rows of the unrolled
+// make_rho() and fieldforce_ik() kernels, e.g. with -DUSE_OMP_SIMD -fopenmp-simd
+
+#if defined(USE_OMP_SIMD) || defined(_OPENMP)
+#define PPPM_SIMD _Pragma("omp simd")
+#else
+#define PPPM_SIMD
+#endif
+
 enum { REVERSE_RHO };
 enum { FORWARD_IK, FORWARD_AD, FORWARD_IK_PERATOM, FORWARD_AD_PERATOM };
 
@@ -72,6 +82,7 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
 
   pppmflag = 1;
   group_group_enable = 1;
+  async_support = 1;
   triclinic = domain->triclinic;
 
   nfactors = 3;
@@ -114,6 +125,9 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   nmax = 0;
   part2grid = nullptr;
 
+  part_order = tile_count = nullptr;
+  nmax_order = ntile_max = nsorted = 0;
+
   // define acons coefficients for estimation of kspace errors
   // see JCP 109, pg 7698 for derivation of coefficients
   // higher order coefficients may be computed if needed
@@ -174,6 +188,8 @@ PPPM::~PPPM()
   if (peratom_allocate_flag) PPPM::deallocate_peratom();
   if (group_allocate_flag) PPPM::deallocate_groups();
   memory->destroy(part2grid);
+  memory->destroy(part_order);
+  memory->destroy(tile_count);
   memory->destroy(acons);
 }
 
@@ -357,7 +373,8 @@ void PPPM::init()
                        estimated_accuracy);
     mesg += fmt::format("  estimated relative force accuracy = {:.8g}\n",
                        estimated_accuracy/two_charge_force);
-    mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
+    mesg += fmt::format("  using {} precision {} FFTs\n",LMP_FFT_PREC,
+                        FFT3d::backend_name(fft_backend));
     mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                        ngrid_max,nfft_both_max);
     utils::logmesg(lmp,mesg);
@@ -839,12 +856,12 @@ void PPPM::allocate()
   fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,fft_backend);
 
   fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,fft_backend);
 
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
@@ -1839,9 +1856,21 @@ void PPPM::particle_map()
 
 void PPPM::make_rho()
 {
+  // unrolled versions with tile-sorted particles for common orders
+
+  switch (order) {
+    case 3: make_rho_order<3>(); return;
+    case 4: make_rho_order<4>(); return;
+    case 5: make_rho_order<5>(); return;
+    case 6: make_rho_order<6>(); return;
+    case 7: make_rho_order<7>(); return;
+  }
+
   int l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
 
+  nsorted = 0;
+
   // clear 3d density array
 
   memset(&(density_brick[nzlo_out][nylo_out][nxlo_out]),0,
@@ -1883,6 +1912,116 @@ void PPPM::make_rho()
   }
 }
 
+/* ----------------------------------------------------------------------
+   charge assignment weights along one dimension for a fixed order,
+   same as compute_rho1d() with stencil index shifted to 0..ORDER-1
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+static inline void rho1d_order(FFT_SCALAR *_noalias r, FFT_SCALAR *const *const coeff,
+                               const FFT_SCALAR d)
+{
+  constexpr int klo = (1 - ORDER) / 2;
+
+  for (int k = 0; k < ORDER; k++) r[k] = ZEROF;
+  for (int l = ORDER - 1; l >= 0; l--) {
+    const FFT_SCALAR *_noalias c = coeff[l] + klo;
+    for (int k = 0; k < ORDER; k++) r[k] = c[k] + r[k] * d;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   sort my particles by tiles of my 3d brick using part2grid,
+   so that consecutive particles share most of their stencil points
+   counting sort, tiles ordered like grid points with x fastest
+------------------------------------------------------------------------- */
+
+void PPPM::sort_by_tile()
+{
+  const int nlocal = atom->nlocal;
+
+  if (nlocal > nmax_order) {
+    memory->destroy(part_order);
+    nmax_order = atom->nmax;
+    memory->create(part_order,nmax_order,"pppm:part_order");
+  }
+
+  const int ntx = ((nxhi_out-nxlo_out) >> TILE_SHIFT) + 1;
+  const int nty = ((nyhi_out-nylo_out) >> TILE_SHIFT) + 1;
+  const int ntz = ((nzhi_out-nzlo_out) >> TILE_SHIFT) + 1;
+  const int ntile = ntx*nty*ntz;
+
+  if (ntile >= ntile_max) {
+    memory->destroy(tile_count);
+    ntile_max = ntile + 1;
+    memory->create(tile_count,ntile_max,"pppm:tile_count");
+  }
+
+  auto tile = [&](int i) {
+    return (((part2grid[i][2]-nzlo_out) >> TILE_SHIFT)*nty +
+            ((part2grid[i][1]-nylo_out) >> TILE_SHIFT))*ntx +
+      ((part2grid[i][0]-nxlo_out) >> TILE_SHIFT);
+  };
+
+  memset(tile_count,0,(ntile+1)*sizeof(int));
+  for (int i = 0; i < nlocal; i++) tile_count[tile(i)+1]++;
+  for (int t = 0; t < ntile; t++) tile_count[t+1] += tile_count[t];
+  for (int i = 0; i < nlocal; i++) part_order[tile_count[tile(i)]++] = i;
+
+  nsorted = nlocal;
+}
+
+/* ----------------------------------------------------------------------
+   make_rho() for a fixed order with particles in tile order
+   stencil rows are contiguous in the brick, so the innermost loop
+   over ORDER grid points is unrolled and vectorized by the compiler
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+void PPPM::make_rho_order()
+{
+  FFT_SCALAR *const density = &(density_brick[nzlo_out][nylo_out][nxlo_out]);
+  memset(density,0,ngrid*sizeof(FFT_SCALAR));
+
+  sort_by_tile();
+
+  double *q = atom->q;
+  double **x = atom->x;
+  const int nxs = nxhi_out - nxlo_out + 1;
+  const int nys = nyhi_out - nylo_out + 1;
+  FFT_SCALAR r0[ORDER], r1[ORDER], r2[ORDER];
+
+  for (int ii = 0; ii < nsorted; ii++) {
+    const int i = part_order[ii];
+    const int nx = part2grid[i][0];
+    const int ny = part2grid[i][1];
+    const int nz = part2grid[i][2];
+    const FFT_SCALAR dx = nx+shiftone - (x[i][0]-boxlo[0])*delxinv;
+    const FFT_SCALAR dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
+    const FFT_SCALAR dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
+
+    rho1d_order<ORDER>(r0,rho_coeff,dx);
+    rho1d_order<ORDER>(r1,rho_coeff,dy);
+    rho1d_order<ORDER>(r2,rho_coeff,dz);
+
+    // first grid point of the stencil
+
+    FFT_SCALAR *corner = density + ((nz+nlower-nzlo_out)*nys + ny+nlower-nylo_out)*nxs +
+      nx+nlower-nxlo_out;
+
+    const FFT_SCALAR z0 = delvolinv * q[i];
+    for (int n = 0; n < ORDER; n++) {
+      const FFT_SCALAR y0 = z0*r2[n];
+      for (int m = 0; m < ORDER; m++) {
+        const FFT_SCALAR x0 = y0*r1[m];
+        FFT_SCALAR *_noalias row = corner + (n*nys + m)*nxs;
+        PPPM_SIMD
+        for (int l = 0; l < ORDER; l++) row[l] += x0*r0[l];
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    remap density from 3d brick decomposition to FFT decomposition
 ------------------------------------------------------------------------- */
@@ -2343,6 +2482,14 @@ void PPPM::fieldforce()
 
 void PPPM::fieldforce_ik()
 {
+  switch (order) {
+    case 3: fieldforce_ik_order<3>(); return;
+    case 4: fieldforce_ik_order<4>(); return;
+    case 5: fieldforce_ik_order<5>(); return;
+    case 6: fieldforce_ik_order<6>(); return;
+    case 7: fieldforce_ik_order<7>(); return;
+  }
+
   int i,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR ekx,eky,ekz;
@@ -2355,7 +2502,7 @@ void PPPM::fieldforce_ik()
 
   double *q = atom->q;
   double **x = atom->x;
-  double **f = atom->f;
+  double **f = get_force();
 
   int nlocal = atom->nlocal;
 
@@ -2395,6 +2542,79 @@ void PPPM::fieldforce_ik()
   }
 }
 
+/* ----------------------------------------------------------------------
+   fieldforce_ik() for a fixed order, particles in tile order if sorted
+   by make_rho(). the field is accumulated separately for each grid
+   point of a stencil row, so the innermost loop is vectorized
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+void PPPM::fieldforce_ik_order()
+{
+  double *q = atom->q;
+  double **x = atom->x;
+  double **f = get_force();
+
+  const int nlocal = atom->nlocal;
+  const bool sorted = (nsorted == nlocal);
+  const int nxs = nxhi_out - nxlo_out + 1;
+  const int nys = nyhi_out - nylo_out + 1;
+  const FFT_SCALAR *const vdx = &(vdx_brick[nzlo_out][nylo_out][nxlo_out]);
+  const FFT_SCALAR *const vdy = &(vdy_brick[nzlo_out][nylo_out][nxlo_out]);
+  const FFT_SCALAR *const vdz = &(vdz_brick[nzlo_out][nylo_out][nxlo_out]);
+  FFT_SCALAR r0[ORDER], r1[ORDER], r2[ORDER];
+  FFT_SCALAR ex[ORDER], ey[ORDER], ez[ORDER];
+
+  for (int ii = 0; ii < nlocal; ii++) {
+    const int i = sorted ? part_order[ii] : ii;
+    const int nx = part2grid[i][0];
+    const int ny = part2grid[i][1];
+    const int nz = part2grid[i][2];
+    const FFT_SCALAR dx = nx+shiftone - (x[i][0]-boxlo[0])*delxinv;
+    const FFT_SCALAR dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
+    const FFT_SCALAR dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
+
+    rho1d_order<ORDER>(r0,rho_coeff,dx);
+    rho1d_order<ORDER>(r1,rho_coeff,dy);
+    rho1d_order<ORDER>(r2,rho_coeff,dz);
+
+    const int corner = ((nz+nlower-nzlo_out)*nys + ny+nlower-nylo_out)*nxs +
+      nx+nlower-nxlo_out;
+
+    for (int l = 0; l < ORDER; l++) ex[l] = ey[l] = ez[l] = ZEROF;
+    for (int n = 0; n < ORDER; n++) {
+      const FFT_SCALAR z0 = r2[n];
+      for (int m = 0; m < ORDER; m++) {
+        const FFT_SCALAR y0 = z0*r1[m];
+        const int row = corner + (n*nys + m)*nxs;
+        const FFT_SCALAR *_noalias gx = vdx + row;
+        const FFT_SCALAR *_noalias gy = vdy + row;
+        const FFT_SCALAR *_noalias gz = vdz + row;
+        PPPM_SIMD
+        for (int l = 0; l < ORDER; l++) {
+          ex[l] += y0*gx[l];
+          ey[l] += y0*gy[l];
+          ez[l] += y0*gz[l];
+        }
+      }
+    }
+
+    FFT_SCALAR ekx = ZEROF, eky = ZEROF, ekz = ZEROF;
+    for (int l = 0; l < ORDER; l++) {
+      ekx -= r0[l]*ex[l];
+      eky -= r0[l]*ey[l];
+      ekz -= r0[l]*ez[l];
+    }
+
+    // convert E-field to force
+
+    const double qfactor = qqrd2e * scale * q[i];
+    f[i][0] += qfactor*ekx;
+    f[i][1] += qfactor*eky;
+    if (slabflag != 2) f[i][2] += qfactor*ekz;
+  }
+}
+
 /* ----------------------------------------------------------------------
    interpolate from grid to get electric field & force on my particles for ad
 ------------------------------------------------------------------------- */
@@ -2425,7 +2645,7 @@ void PPPM::fieldforce_ad()
 
   double *q = atom->q;
   double **x = atom->x;
-  double **f = atom->f;
+  double **f = get_force();
 
   int nlocal = atom->nlocal;
 
@@ -2906,7 +3126,7 @@ void PPPM::slabcorr()
   // add on force corrections
 
   double ffact = qscale * (-4.0*MY_PI/volume);
-  double **f = atom->f;
+  double **f = get_force();
 
   for (int i = 0; i < nlocal; i++) f[i][2] += ffact * q[i]*(dipole_all - qsum*x[i][2]);
 }
@@ -2978,6 +3198,8 @@ int PPPM::timing_3d(int n, double &time3d)
 double PPPM::memory_usage()
 {
   double bytes = (double)nmax*3 * sizeof(double);
+  bytes += (double)nmax_order * sizeof(int);
+  bytes += (double)ntile_max * sizeof(int);
 
   int nbrick = (nxhi_out-nxlo_out+1) * (nyhi_out-nylo_out+1) *
     (nzhi_out-nzlo_out+1);
@@ -94,6 +94,11 @@ class PPPM : public KSpace {
   int **part2grid;    // storage for particle -> grid mapping
   int nmax;
 
+  int *part_order;    // local atoms sorted by grid tile in make_rho()
+  int *tile_count;    // atoms per tile while sorting
+  int nmax_order, ntile_max;
+  int nsorted;        // # of atoms in part_order, 0 if not sorted
+
   double *boxlo;
   // TIP4P settings
   int typeH, typeO;    // atom types of TIP4P water H and O atoms
@@ -122,6 +127,8 @@ class PPPM : public KSpace {
 
   virtual void particle_map();
   virtual void make_rho();
+  void sort_by_tile();
+  template <int ORDER> void make_rho_order();
   virtual void brick2fft();
 
   virtual void poisson();
@@ -130,6 +137,7 @@ class PPPM : public KSpace {
 
   virtual void fieldforce();
   virtual void fieldforce_ik();
+  template <int ORDER> void fieldforce_ik_order();
   virtual void fieldforce_ad();
 
   virtual void poisson_peratom();
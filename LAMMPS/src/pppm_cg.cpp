@@ -381,7 +381,7 @@ void PPPMCG::fieldforce_ik()
 
   double *q = atom->q;
   double **x = atom->x;
-  double **f = atom->f;
+  double **f = get_force();
 
   for (int j = 0; j < num_charged; j++) {
     i = is_charged[j];
@@ -453,7 +453,7 @@ void PPPMCG::fieldforce_ad()
 
   double *q = atom->q;
   double **x = atom->x;
-  double **f = atom->f;
+  double **f = get_force();
 
   for (int j = 0; j < num_charged; j++) {
     i = is_charged[j];
@@ -644,7 +644,7 @@ void PPPMCG::slabcorr()
   // add on force corrections
 
   const double ffact = qscale * (-MY_4PI/volume);
-  double * const * const f = atom->f;
+  double * const * const f = get_force();
 
   for (j = 0; j < num_charged; j++) {
     i = is_charged[j];
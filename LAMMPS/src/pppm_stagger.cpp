@@ -776,7 +776,7 @@ void PPPMStagger::fieldforce_ik()
 
   double *q = atom->q;
   double **x = atom->x;
-  double **f = atom->f;
+  double **f = get_force();
 
   int nlocal = atom->nlocal;
 
@@ -846,7 +846,7 @@ void PPPMStagger::fieldforce_ad()
 
   double *q = atom->q;
   double **x = atom->x;
-  double **f = atom->f;
+  double **f = get_force();
 
   int nlocal = atom->nlocal;
 
@@ -181,7 +181,7 @@ void PPPMTIP4P::fieldforce_ik()
   // ek = 3 components of E-field on particle
   double *q = atom->q;
   double **x = atom->x;
-  double **f = atom->f;
+  double **f = get_force();
 
   int *type = atom->type;
   int nlocal = atom->nlocal;
@@ -283,7 +283,7 @@ void PPPMTIP4P::fieldforce_ad()
 
   double *q = atom->q;
   double **x = atom->x;
-  double **f = atom->f;
+  double **f = get_force();
 
   int *type = atom->type;
   int nlocal = atom->nlocal;
@@ -537,7 +537,7 @@ void PPPMTIP4P::slabcorr()
   // add on force corrections
 
   double ffact = qscale * (-4.0*MY_PI/volume);
-  double **f = atom->f;
+  double **f = get_force();
 
   for (int i = 0; i < nlocal; i++) {
     double fzi_corr = ffact * q[i]*(dipole_all - qsum*x[i][2]);
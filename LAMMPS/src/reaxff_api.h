@@ -108,6 +108,11 @@ inline int Num_Entries(int i, reax_list *l)
 {
   return l->end_index[i] - l->index[i];
 }
+inline void Set_List_Top(int top, reax_list *l)
+{
+  l->top = top;
+  if (top > l->max_top) l->max_top = top;
+}
 
 // lookup
 
@@ -143,6 +148,10 @@ extern void Reset_Workspace(reax_system *, storage *);
 extern void *scalloc(LAMMPS_NS::Error *, rc_bigint, rc_bigint, const std::string &);
 extern void *smalloc(LAMMPS_NS::Error *, rc_bigint, const std::string &);
 extern void sfree(void *);
+extern rc_bigint Arena_Chunk(rc_bigint);
+extern void Arena_Reset(LAMMPS_NS::Error *, reax_arena *, rc_bigint, const std::string &);
+extern void *Arena_Take(LAMMPS_NS::Error *, reax_arena *, rc_bigint);
+extern void Arena_Free(reax_arena *);
 
 // torsion angles
 
@@ -81,6 +81,8 @@ namespace ReaxFF {
         total_bonds += system->my_atoms[i].num_bonds;
       }
 
+      Set_List_Top(total_bonds, bonds);
+
       /* is reallocation needed? */
       if (total_bonds >= bonds->num_intrs * DANGER_ZONE) {
         workspace->realloc.bonds = 1;
@@ -105,6 +107,8 @@ namespace ReaxFF {
         }
       }
 
+      Set_List_Top(total_hbonds, hbonds);
+
       /* is reallocation needed? */
       if (total_hbonds >= hbonds->num_intrs * 0.90/*DANGER_ZONE*/) {
         workspace->realloc.hbonds = 1;
@@ -103,4 +103,48 @@ void sfree(void *ptr)
   free(ptr);
   ptr = nullptr;
 }
+
+/* chunks are padded to this many bytes, keeping every chunk
+   aligned like the start of the block */
+static constexpr rc_bigint ARENA_ALIGN = 64;
+
+/* bytes taken from an arena by a chunk of n bytes */
+rc_bigint Arena_Chunk(rc_bigint n)
+{
+  return (n + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+}
+
+/* start handing out chunks from the beginning of the arena.
+   the block is only reallocated when it is smaller than n bytes,
+   in which case the old contents are lost */
+void Arena_Reset(LAMMPS_NS::Error *error_ptr, reax_arena *a, rc_bigint n, const std::string &name)
+{
+  if (n > a->cap) {
+    sfree(a->base);
+    a->base = (char *) smalloc(error_ptr, n, name);
+    a->cap = n;
+    ++a->nalloc;
+  }
+  a->used = 0;
+}
+
+/* next chunk of n bytes. the caller must have reserved the sum
+   of Arena_Chunk() of all chunks with Arena_Reset() */
+void *Arena_Take(LAMMPS_NS::Error *error_ptr, reax_arena *a, rc_bigint n)
+{
+  void *ptr = a->base + a->used;
+  if (a->used + Arena_Chunk(n) > a->cap)
+    error_ptr->one(FLERR, "ReaxFF arena overflow: {} bytes requested with {} of {} bytes used", n,
+                   a->used, a->cap);
+  a->used += Arena_Chunk(n);
+  return ptr;
+}
+
+/* release the block of an arena */
+void Arena_Free(reax_arena *a)
+{
+  sfree(a->base);
+  a->base = nullptr;
+  a->cap = a->used = 0;
+}
 }    // namespace ReaxFF
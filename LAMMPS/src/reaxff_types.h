@@ -317,8 +317,19 @@ struct reallocate_data {
   int num_3body;
 };
 
+/* grow-only memory block that is handed out in consecutive chunks.
+   it keeps its largest size, so rebuilding the same arrays with
+   equal or smaller sizes does not allocate again */
+struct reax_arena {
+  char *base;
+  rc_bigint cap;     // allocated bytes
+  rc_bigint used;    // bytes handed out since the last Arena_Reset()
+  int nalloc;        // number of times the block was allocated
+};
+
 struct storage {
   int allocated;
+  reax_arena arena;    // backs the per-atom arrays
 
   /* bond order related storage */
   double *total_bond_order;
@@ -365,6 +376,11 @@ struct reax_list {
 
   int type;
   list_type select;
+
+  int top;            // entries in use after the last rebuild
+  int max_top;        // largest top since the list was created
+  reax_arena mem;     // backs index, end_index and select
+
   class LAMMPS_NS::Error *error_ptr;
 };
 
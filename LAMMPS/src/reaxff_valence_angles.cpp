@@ -375,6 +375,8 @@ namespace ReaxFF {
       }
     }
 
+    Set_List_Top(num_thb_intrs, thb_intrs);
+
     if (num_thb_intrs >= thb_intrs->num_intrs * DANGER_ZONE) {
       workspace->realloc.num_3body = num_thb_intrs;
       if (num_thb_intrs > thb_intrs->num_intrs)
@@ -525,6 +525,7 @@ void Respa::run(int n)
       update->nsteps = i;
       break;
     }
+    if (timer->check_budget(i)) break;
 
     ntimestep = ++update->ntimestep;
     ev_set(ntimestep);
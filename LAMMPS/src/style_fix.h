@@ -58,10 +58,12 @@
 #include "fix_nve.h"
 #include "fix_nve_limit.h"
 #include "fix_nve_noforce.h"
+#include "fix_nve_omp.h"
 #include "fix_nve_sphere.h"
 #include "fix_nvt.h"
 #include "fix_nvt_sllod.h"
 #include "fix_nvt_sphere.h"
+#include "fix_omp.h"
 #include "fix_pair.h"
 #include "fix_planeforce.h"
 #include "fix_pour.h"
@@ -114,6 +116,7 @@
 #include "fix_tune_kspace.h"
 #include "fix_vector.h"
 #include "fix_viscous.h"
+#include "fix_viz_ring.h"
 #include "fix_wall_harmonic.h"
 #include "fix_wall_lj1043.h"
 #include "fix_wall_lj126.h"
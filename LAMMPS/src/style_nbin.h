@@ -1,2 +1,3 @@
 #include "nbin_multi.h"
+#include "nbin_sorted.h"
 #include "nbin_standard.h"
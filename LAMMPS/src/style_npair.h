@@ -1,11 +1,16 @@
 #include "npair_bin.h"
 #include "npair_bin_ghost.h"
+#include "npair_bin_omp.h"
+#include "npair_bin_sorted.h"
+#include "npair_cluster.h"
 #include "npair_copy.h"
 #include "npair_halffull.h"
+#include "npair_halffull_omp.h"
 #include "npair_multi.h"
 #include "npair_multi_old.h"
 #include "npair_nsq.h"
 #include "npair_nsq_ghost.h"
+#include "npair_nsq_omp.h"
 #include "npair_respa_bin.h"
 #include "npair_respa_nsq.h"
 #include "npair_skip.h"
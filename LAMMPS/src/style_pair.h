@@ -51,9 +51,11 @@
 #include "pair_lj_class2_coul_cut.h"
 #include "pair_lj_class2_coul_long.h"
 #include "pair_lj_cut.h"
+#include "pair_lj_cut_cluster.h"
 #include "pair_lj_cut_coul_cut.h"
 #include "pair_lj_cut_coul_long.h"
 #include "pair_lj_cut_coul_msm.h"
+#include "pair_lj_cut_omp.h"
 #include "pair_lj_cut_tip4p_cut.h"
 #include "pair_lj_cut_tip4p_long.h"
 #include "pair_lj_expand.h"
@@ -63,6 +65,8 @@
 #include "pair_meam_spline.h"
 #include "pair_meam_sw_spline.h"
 #include "pair_morse.h"
+#include "pair_morse_cluster.h"
+#include "pair_morse_omp.h"
 #include "pair_nb3b_harmonic.h"
 #include "pair_nb3b_screened.h"
 #include "pair_polymorphic.h"
@@ -75,10 +79,14 @@
 #include "pair_sw.h"
 #include "pair_sw_angle_table.h"
 #include "pair_sw_mod.h"
+#include "pair_sw_omp.h"
+#include "pair_sw_precision.h"
 #include "pair_table.h"
 #include "pair_tersoff.h"
 #include "pair_tersoff_mod.h"
 #include "pair_tersoff_mod_c.h"
+#include "pair_tersoff_omp.h"
+#include "pair_tersoff_precision.h"
 #include "pair_tersoff_table.h"
 #include "pair_tersoff_zbl.h"
 #include "pair_threebody_table.h"
@@ -86,7 +94,11 @@
 #include "pair_tip4p_long.h"
 #include "pair_tracker.h"
 #include "pair_vashishta.h"
+#include "pair_vashishta_omp.h"
+#include "pair_vashishta_precision.h"
+#include "pair_vashishta_simd.h"
 #include "pair_vashishta_table.h"
+#include "pair_vashishta_table_omp.h"
 #include "pair_yukawa.h"
 #include "pair_zbl.h"
 #include "pair_zero.h"
@@ -0,0 +1,140 @@
+/* -------------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   work-stealing loop scheduler for threaded styles
+------------------------------------------------------------------------- */
+
+#include "thr_sched.h"
+
+using namespace LAMMPS_NS;
+
+// the owner takes about 1/CHUNKS_PER_THREAD of its initial range at a time
+static constexpr int CHUNKS_PER_THREAD = 16;
+// but at least MINCHUNK atoms, to keep the scheduling overhead small
+static constexpr int MINCHUNK = 8;
+
+static inline uint64_t pack(uint32_t from, uint32_t to)
+{
+  return ((uint64_t) from << 32) | to;
+}
+
+/* ---------------------------------------------------------------------- */
+
+ThrSched::ThrSched() : _range(nullptr), _stolen(nullptr), _nmax(0), _nthr(0), _chunk(1), _steal(false) {}
+
+/* ---------------------------------------------------------------------- */
+
+ThrSched::~ThrSched()
+{
+  delete[] _range;
+  delete[] _stolen;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ThrSched::setup(int inum, int nthreads)
+{
+  if (nthreads > _nmax) {
+    delete[] _range;
+    delete[] _stolen;
+    _nmax = nthreads;
+    _range = new Range[_nmax];
+    _stolen = new std::vector<std::pair<int, int>>[_nmax];
+  }
+  _nthr = nthreads;
+
+  // same split as loop_setup_thr(). without stealing, each thread
+  // takes its whole range at once
+
+  const int idelta = 1 + inum / nthreads;
+  for (int tid = 0; tid < nthreads; ++tid) {
+    const int ifrom = (tid * idelta > inum) ? inum : tid * idelta;
+    const int ito = ((ifrom + idelta) > inum) ? inum : ifrom + idelta;
+    _range[tid].bounds.store(pack(ifrom, ito));
+    _stolen[tid].clear();
+  }
+
+  if (_steal) {
+    _chunk = idelta / CHUNKS_PER_THREAD;
+    if (_chunk < MINCHUNK) _chunk = MINCHUNK;
+  } else _chunk = idelta;
+}
+
+/* ----------------------------------------------------------------------
+   take the next chunk from the front of the own range
+------------------------------------------------------------------------- */
+
+bool ThrSched::pop(int tid, int &ifrom, int &ito)
+{
+  std::atomic<uint64_t> &bounds = _range[tid].bounds;
+  uint64_t old = bounds.load();
+  while (true) {
+    const uint32_t from = old >> 32;
+    const uint32_t to = old & 0xffffffffU;
+    if (from >= to) return false;
+    const uint32_t next = (to - from > (uint32_t) _chunk) ? from + _chunk : to;
+    if (bounds.compare_exchange_weak(old, pack(next, to))) {
+      ifrom = from;
+      ito = next;
+      return true;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   move the upper half of the remaining range of victim to thread tid
+   only called when the range of tid is empty, so no other thread can
+   modify it concurrently: a compare-and-swap on an empty range is never
+   attempted, and a stale non-empty value does not match
+------------------------------------------------------------------------- */
+
+bool ThrSched::steal(int tid, int victim)
+{
+  std::atomic<uint64_t> &bounds = _range[victim].bounds;
+  uint64_t old = bounds.load();
+  while (true) {
+    const uint32_t from = old >> 32;
+    const uint32_t to = old & 0xffffffffU;
+    if (from >= to) return false;
+    const uint32_t mid = (to - from > (uint32_t) _chunk) ? from + (to - from) / 2 : from;
+    if (bounds.compare_exchange_weak(old, pack(from, mid))) {
+      _range[tid].bounds.store(pack(mid, to));
+      _stolen[tid].emplace_back(mid, to);
+      return true;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+bool ThrSched::next(int tid, int &ifrom, int &ito)
+{
+  // work only moves between ranges, so a thread can stop once a full
+  // pass over all other threads finds nothing left. a range that is in
+  // transit to a thief is completed by that thief.
+
+  while (true) {
+    if (pop(tid, ifrom, ito)) return true;
+    if (!_steal) return false;
+
+    bool found = false;
+    for (int i = 1; i < _nthr; ++i) {
+      if (steal(tid, (tid + i) % _nthr)) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) return false;
+  }
+}
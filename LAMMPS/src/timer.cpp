@@ -32,6 +32,8 @@ Timer::Timer(LAMMPS *_lmp) : Pointers(_lmp)
   _s_timeout = -1;
   _checkfreq = 10;
   _nextcheck = -1;
+  _budget = -1.0;
+  budget_start = budget_laststep = 0.0;
   this->_stamp(RESET);
 }
 
@@ -197,6 +199,33 @@ bool Timer::_check_timeout()
   }
 }
 
+/* ---------------------------------------------------------------------- */
+
+void Timer::init_budget(double seconds)
+{
+  _budget = (seconds < 0.0) ? 0.0 : seconds;
+  budget_start = budget_laststep = platform::walltime();
+}
+
+/* ----------------------------------------------------------------------
+   stop before a step that is expected to end past the budget, using the
+   duration of the previous step as estimate. the first step of a budget
+   is always done, so progress is made even if a single step is too slow.
+------------------------------------------------------------------------- */
+
+bool Timer::_check_budget(int step)
+{
+  double now = platform::walltime();
+  double steptime = now - budget_laststep;
+  budget_laststep = now;
+  if (step == 0) return false;
+
+  // broadcast decision to ensure all ranks act the same.
+  int expired = (now - budget_start + steptime > _budget) ? 1 : 0;
+  MPI_Bcast(&expired, 1, MPI_INT, 0, world);
+  return expired != 0;
+}
+
 /* ---------------------------------------------------------------------- */
 double Timer::get_timeout_remain()
 {
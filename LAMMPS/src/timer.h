@@ -39,6 +39,7 @@ class Timer : protected Pointers {
     NEB,
     REPCOMM,
     REPOUT,
+    IDLE,
     NUM_TIMER
   };
   enum tlevel { OFF = 0, LOOP, NORMAL, FULL };
@@ -102,6 +103,21 @@ class Timer : protected Pointers {
       return _check_timeout();
   }
 
+  // start a wall time budget in seconds for the following steps
+  void init_budget(double);
+
+  // disable the wall time budget
+  void clear_budget() { _budget = -1.0; }
+
+  // check if the next step would exceed the wall time budget.
+  // inline wrapper around internal function to reduce overhead
+  // in case there is no budget.
+  bool check_budget(int step)
+  {
+    if (_budget < 0.0) return false;
+    return _check_budget(step);
+  }
+
   void modify_params(int, char **);
 
  private:
@@ -117,11 +133,18 @@ class Timer : protected Pointers {
   int _checkfreq;    // frequency of timeout checking
   int _nextcheck;    // loop number of next timeout check
 
+  double _budget;            // wall time budget in seconds. none if negative
+  double budget_start;       // wall time when the budget was started
+  double budget_laststep;    // wall time of the previous budget check
+
   // update one specific timer array
   void _stamp(enum ttype);
 
   // check for timeout
   bool _check_timeout();
+
+  // check for exhausted wall time budget
+  bool _check_budget(int);
 };
 
 }    // namespace LAMMPS_NS
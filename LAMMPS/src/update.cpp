@@ -58,6 +58,7 @@ Update::Update(LAMMPS *lmp) :
   first_update = 0;
 
   whichflag = 0;
+  incremental = 0;
   firststep = laststep = 0;
   beginstep = endstep = 0;
   restrict_output = 0;
@@ -38,6 +38,7 @@ class Update : protected Pointers {
   bigint ntimestep;              // current step (dynamics or min iterations)
   int nsteps;                    // # of steps to run (dynamics or min iter)
   int whichflag;                 // 0 for unset, 1 for dynamics, 2 for min
+  int incremental;               // 1 while an incremental library run is open
   double atime;                  // simulation time at atimestep
   bigint atimestep;              // last timestep atime was updated
   bigint firststep, laststep;    // 1st & last step of this run
@@ -1784,6 +1784,45 @@ void utils::merge_sort(int *index, int num, void *ptr, int (*comp)(int, int, voi
   delete[] buf;
 }
 
+/* ----------------------------------------------------------------------
+ * Morton rank of grid cells: sort cell indices by interleaved bits
+------------------------------------------------------------------------- */
+
+static int compare_morton(int i, int j, void *ptr)
+{
+  auto code = (uint64_t *) ptr;
+  if (code[i] < code[j]) return -1;
+  if (code[i] > code[j]) return 1;
+  return 0;
+}
+
+void utils::morton_rank(int nx, int ny, int nz, int *rank)
+{
+  const int ncell = nx * ny * nz;
+  auto code = new uint64_t[ncell];
+  auto order = new int[ncell];
+
+  for (int iz = 0; iz < nz; iz++)
+    for (int iy = 0; iy < ny; iy++)
+      for (int ix = 0; ix < nx; ix++) {
+        const int icell = (iz * ny + iy) * nx + ix;
+        uint64_t c = 0;
+        for (int b = 0; b < 21; b++) {
+          c |= (uint64_t) ((ix >> b) & 1) << (3 * b);
+          c |= (uint64_t) ((iy >> b) & 1) << (3 * b + 1);
+          c |= (uint64_t) ((iz >> b) & 1) << (3 * b + 2);
+        }
+        code[icell] = c;
+        order[icell] = icell;
+      }
+
+  merge_sort(order, ncell, (void *) code, compare_morton);
+  for (int i = 0; i < ncell; i++) rank[order[i]] = i;
+
+  delete[] code;
+  delete[] order;
+}
+
 /* ------------------------------------------------------------------ */
 
 /* ----------------------------------------------------------------------
@@ -760,6 +760,20 @@ or the *-suffix/-sf* command line flag and return correspondingly modified strin
    * \param  comp   Pointer to comparison function */
 
   void merge_sort(int *index, int num, void *ptr, int (*comp)(int, int, void *));
+
+  /*! Rank the cells of a 3d grid along a Morton (Z-order) curve
+   *
+   * Cells are numbered x fastest, i.e. (iz * ny + iy) * nx + ix.
+   * On return rank[cell] is the position of the cell when all cells
+   * are ordered by interleaving the bits of their ix, iy, iz indices,
+   * so cells close in space get close ranks.
+   *
+   * \param  nx    number of cells in x
+   * \param  ny    number of cells in y
+   * \param  nz    number of cells in z
+   * \param  rank  array of length nx*ny*nz that receives the ranks */
+
+  void morton_rank(int nx, int ny, int nz, int *rank);
 }    // namespace utils
 }    // namespace LAMMPS_NS
 
@@ -84,6 +84,15 @@ void Verlet::init()
   // orthogonal vs triclinic simulation box
 
   triclinic = domain->triclinic;
+
+  // solve kspace only every N steps and/or overlap kspace with pair
+  // and bond computations if requested and possible
+
+  kspace_every = kspace_async = 0;
+  if (force->kspace && kspace_compute_flag) {
+    kspace_every = force->kspace->every_check();
+    kspace_async = force->kspace->async_check();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -149,7 +158,8 @@ void Verlet::setup(int flag)
 
   if (force->kspace) {
     force->kspace->setup();
-    if (kspace_compute_flag) force->kspace->compute(eflag,vflag);
+    if (kspace_every) force->kspace->compute_every(eflag,vflag);
+    else if (kspace_compute_flag) force->kspace->compute(eflag,vflag);
     else force->kspace->compute_dummy(eflag,vflag);
   }
 
@@ -211,7 +221,8 @@ void Verlet::setup_minimal(int flag)
 
   if (force->kspace) {
     force->kspace->setup();
-    if (kspace_compute_flag) force->kspace->compute(eflag,vflag);
+    if (kspace_every) force->kspace->compute_every(eflag,vflag);
+    else if (kspace_compute_flag) force->kspace->compute(eflag,vflag);
     else force->kspace->compute_dummy(eflag,vflag);
   }
 
@@ -248,6 +259,7 @@ void Verlet::run(int n)
       update->nsteps = i;
       break;
     }
+    if (timer->check_budget(i)) break;
 
     ntimestep = ++update->ntimestep;
     ev_set(ntimestep);
@@ -312,6 +324,11 @@ void Verlet::run(int n)
       timer->stamp(Timer::MODIFY);
     }
 
+    // with async kspace, kspace runs on a helper thread with its own
+    // force buffer and only the remaining wait is timed as KSPACE
+
+    if (kspace_async) force->kspace->compute_async(eflag,vflag);
+
     if (pair_compute_flag) {
       force->pair->compute(eflag,vflag);
       timer->stamp(Timer::PAIR);
@@ -325,7 +342,13 @@ void Verlet::run(int n)
       timer->stamp(Timer::BOND);
     }
 
-    if (kspace_compute_flag) {
+    if (kspace_async) {
+      force->kspace->compute_wait();
+      timer->stamp(Timer::KSPACE);
+    } else if (kspace_every) {
+      force->kspace->compute_every(eflag,vflag);
+      timer->stamp(Timer::KSPACE);
+    } else if (kspace_compute_flag) {
       force->kspace->compute(eflag,vflag);
       timer->stamp(Timer::KSPACE);
     }
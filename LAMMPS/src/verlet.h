@@ -37,6 +37,8 @@ class Verlet : public Integrate {
  protected:
   int triclinic;    // 0 if domain is orthog, 1 if triclinic
   int torqueflag, extraflag;
+  int kspace_async;    // 1 if kspace runs concurrently with pair and bond styles
+  int kspace_every;    // 1 if kspace solves only every N steps
 };
 
 }    // namespace LAMMPS_NS